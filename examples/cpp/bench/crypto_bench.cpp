@@ -0,0 +1,182 @@
+/**
+ * Google Benchmark microbenchmarks for whisper_crypto
+ *
+ * Release gating: run with --benchmark_format=json and compare
+ * bytes_per_second / items_per_second against the previous release.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "crypto/hex.h"
+#include "crypto/keccak256.h"
+#include "crypto/keccak256_f.h"
+#include "crypto/secp256k1_wrapper.h"
+
+using namespace whisper::crypto;
+
+namespace {
+
+std::vector<uint8_t> patternedInput(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 2654435761u >> 13);
+    }
+    return data;
+}
+
+} // namespace
+
+// --- Keccak-256 --------------------------------------------------------------
+
+static void BM_KeccakUpdate(benchmark::State& state) {
+    const auto data = patternedInput(static_cast<size_t>(state.range(0)));
+    uint8_t digest[Keccak256::HASH_SIZE];
+    for (auto _ : state) {
+        Keccak256 hasher;
+        hasher.update(data.data(), data.size());
+        hasher.finalize(digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_KeccakUpdate)->RangeMultiplier(8)->Range(64, 16 << 20);
+
+static void BM_KeccakPermutation(benchmark::State& state) {
+    uint64_t lanes[25] = {};
+    for (auto _ : state) {
+        detail::keccakPermute(lanes);
+        benchmark::DoNotOptimize(lanes);
+    }
+    state.SetBytesProcessed(state.iterations() * 200);
+}
+BENCHMARK(BM_KeccakPermutation);
+
+static void BM_KeccakHashBatch(benchmark::State& state) {
+    constexpr size_t COUNT = 64;
+    constexpr size_t MESSAGE_SIZE = 200;
+    const auto backing = patternedInput(COUNT * MESSAGE_SIZE);
+    const uint8_t* inputs[COUNT];
+    size_t lengths[COUNT];
+    for (size_t i = 0; i < COUNT; ++i) {
+        inputs[i] = backing.data() + i * MESSAGE_SIZE;
+        lengths[i] = MESSAGE_SIZE;
+    }
+    uint8_t outputs[COUNT * Keccak256::HASH_SIZE];
+    for (auto _ : state) {
+        Keccak256::hashBatch(inputs, lengths, COUNT, outputs);
+        benchmark::DoNotOptimize(outputs);
+    }
+    state.SetItemsProcessed(state.iterations() * COUNT);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(backing.size()));
+}
+BENCHMARK(BM_KeccakHashBatch);
+
+// --- secp256k1 ---------------------------------------------------------------
+
+static void BM_Secp256k1Sign(benchmark::State& state) {
+    SECP256k1Wrapper secp;
+    const KeyPair keyPair = secp.generateKeyPair();
+    uint8_t hash[32];
+    for (int i = 0; i < 32; ++i) hash[i] = static_cast<uint8_t>(i);
+    uint8_t signature[64];
+    uint8_t recoveryId;
+    for (auto _ : state) {
+        secp.sign(keyPair.privateKey, hash, signature, &recoveryId);
+        benchmark::DoNotOptimize(signature);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Secp256k1Sign);
+
+static void BM_Secp256k1SessionSign(benchmark::State& state) {
+    SECP256k1Wrapper secp;
+    const KeyPair keyPair = secp.generateKeyPair();
+    SigningSession session(keyPair.privateKey);
+    uint8_t hash[32];
+    for (int i = 0; i < 32; ++i) hash[i] = static_cast<uint8_t>(i);
+    uint8_t signature[64];
+    uint8_t recoveryId;
+    for (auto _ : state) {
+        session.sign(hash, signature, &recoveryId);
+        benchmark::DoNotOptimize(signature);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Secp256k1SessionSign);
+
+static void BM_Secp256k1Verify(benchmark::State& state) {
+    SECP256k1Wrapper secp;
+    const KeyPair keyPair = secp.generateKeyPair();
+    uint8_t hash[32];
+    for (int i = 0; i < 32; ++i) hash[i] = static_cast<uint8_t>(i);
+    uint8_t signature[64];
+    uint8_t recoveryId;
+    secp.sign(keyPair.privateKey, hash, signature, &recoveryId);
+    for (auto _ : state) {
+        bool ok = secp.verify(keyPair.publicKey, hash, signature);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Secp256k1Verify);
+
+static void BM_Secp256k1Recover(benchmark::State& state) {
+    SECP256k1Wrapper secp;
+    const KeyPair keyPair = secp.generateKeyPair();
+    uint8_t hash[32];
+    for (int i = 0; i < 32; ++i) hash[i] = static_cast<uint8_t>(i);
+    uint8_t signature[64];
+    uint8_t recoveryId;
+    secp.sign(keyPair.privateKey, hash, signature, &recoveryId);
+    uint8_t recovered[64];
+    for (auto _ : state) {
+        secp.recoverPublicKey(hash, signature, recoveryId, recovered);
+        benchmark::DoNotOptimize(recovered);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Secp256k1Recover);
+
+static void BM_VerifyBatch(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    SECP256k1Wrapper secp;
+    std::vector<KeyPair> keys(count);
+    secp.generateKeyPairs(keys.data(), count);
+    std::vector<uint8_t> hashes(count * 32);
+    std::vector<uint8_t> signatures(count * 64);
+    std::vector<VerifyJob> jobs(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (int j = 0; j < 32; ++j) {
+            hashes[i * 32 + j] = static_cast<uint8_t>(i + j);
+        }
+        uint8_t recoveryId;
+        secp.sign(keys[i].privateKey, &hashes[i * 32], &signatures[i * 64], &recoveryId);
+        jobs[i] = {keys[i].publicKey, &hashes[i * 32], &signatures[i * 64]};
+    }
+    std::vector<uint64_t> results((count + 63) / 64);
+    for (auto _ : state) {
+        size_t valid = secp.verifyBatch(jobs.data(), count, results.data());
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_VerifyBatch)->Arg(16)->Arg(256);
+
+// --- hex ---------------------------------------------------------------------
+
+static void BM_BytesToHex(benchmark::State& state) {
+    const auto data = patternedInput(static_cast<size_t>(state.range(0)));
+    std::vector<char> out(data.size() * 2);
+    for (auto _ : state) {
+        hex::encode(data.data(), data.size(), out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+BENCHMARK(BM_BytesToHex)->Arg(32)->Arg(4096);
+
+BENCHMARK_MAIN();
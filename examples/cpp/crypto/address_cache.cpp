@@ -0,0 +1,94 @@
+/**
+ * Ethereum address derivation cache
+ */
+
+#include "address_cache.h"
+#include "keccak256.h"
+
+#include <cstring>
+
+namespace whisper {
+namespace crypto {
+
+namespace {
+
+// Public keys are curve points, so their leading bytes are already
+// uniformly distributed; fold two words for the table index
+uint64_t fingerprint(const uint8_t publicKey[64]) {
+    uint64_t a, b;
+    std::memcpy(&a, publicKey, 8);
+    std::memcpy(&b, publicKey + 32, 8);
+    return a ^ (b * 0x9E3779B97F4A7C15ULL);
+}
+
+} // namespace
+
+AddressCache::AddressCache(size_t capacity)
+    : mask_(0), hits_(0), misses_(0) {
+    size_t rounded = PROBE_WINDOW;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    entries_.resize(rounded);
+    for (Entry& entry : entries_) {
+        entry.used = false;
+        entry.referenced = false;
+    }
+    mask_ = rounded - 1;
+}
+
+void AddressCache::computeAddress(const uint8_t publicKey[64], uint8_t address[ADDRESS_SIZE]) {
+    Keccak256 hasher;
+    uint8_t digest[Keccak256::HASH_SIZE];
+    hasher.update(publicKey, 64);
+    hasher.finalize(digest);
+    std::memcpy(address, digest + (Keccak256::HASH_SIZE - ADDRESS_SIZE), ADDRESS_SIZE);
+}
+
+void AddressCache::deriveAddress(const uint8_t publicKey[64], uint8_t address[ADDRESS_SIZE]) {
+    const size_t home = static_cast<size_t>(fingerprint(publicKey)) & mask_;
+
+    // Probe the window for a hit or the first free slot
+    size_t freeSlot = SIZE_MAX;
+    for (size_t i = 0; i < PROBE_WINDOW; ++i) {
+        Entry& entry = entries_[(home + i) & mask_];
+        if (!entry.used) {
+            if (freeSlot == SIZE_MAX) {
+                freeSlot = (home + i) & mask_;
+            }
+            continue;
+        }
+        if (std::memcmp(entry.publicKey, publicKey, 64) == 0) {
+            entry.referenced = true;
+            std::memcpy(address, entry.address, ADDRESS_SIZE);
+            ++hits_;
+            return;
+        }
+    }
+
+    ++misses_;
+    computeAddress(publicKey, address);
+
+    // Insert: free slot if any, else clock-evict within the window
+    size_t victim = freeSlot;
+    if (victim == SIZE_MAX) {
+        victim = home & mask_;
+        for (size_t i = 0; i < PROBE_WINDOW; ++i) {
+            Entry& entry = entries_[(home + i) & mask_];
+            if (!entry.referenced) {
+                victim = (home + i) & mask_;
+                break;
+            }
+            entry.referenced = false;  // second chance
+        }
+    }
+
+    Entry& entry = entries_[victim];
+    std::memcpy(entry.publicKey, publicKey, 64);
+    std::memcpy(entry.address, address, ADDRESS_SIZE);
+    entry.used = true;
+    entry.referenced = false;
+}
+
+} // namespace crypto
+} // namespace whisper
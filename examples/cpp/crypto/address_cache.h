@@ -0,0 +1,64 @@
+#ifndef WHISPER_CRYPTO_ADDRESS_CACHE_H
+#define WHISPER_CRYPTO_ADDRESS_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Ethereum address derivation cache keyed by public key
+ *
+ * An address is the last 20 bytes of Keccak-256 over the 64-byte
+ * public key. Traffic is dominated by a few thousand repeat senders,
+ * so this caches derivations in an open-addressing table over one
+ * fixed arena (no per-entry heap allocation): hot senders cost a
+ * single bounded probe instead of a full permutation.
+ *
+ * Eviction is clock-style within each key's probe window. Instances
+ * are not thread-safe; use one per thread.
+ */
+class AddressCache {
+public:
+    static constexpr size_t ADDRESS_SIZE = 20;
+    static constexpr size_t PROBE_WINDOW = 8;
+
+    /**
+     * @brief Create a cache
+     * @param capacity Entry count, rounded up to a power of two
+     */
+    explicit AddressCache(size_t capacity = 4096);
+
+    /**
+     * @brief Derive (or fetch) the address for a public key
+     */
+    void deriveAddress(const uint8_t publicKey[64], uint8_t address[ADDRESS_SIZE]);
+
+    /**
+     * @brief Uncached derivation: Keccak-256(publicKey)[12..31]
+     */
+    static void computeAddress(const uint8_t publicKey[64], uint8_t address[ADDRESS_SIZE]);
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+private:
+    struct Entry {
+        uint8_t publicKey[64];
+        uint8_t address[ADDRESS_SIZE];
+        bool used;
+        bool referenced;
+    };
+
+    std::vector<Entry> entries_;
+    size_t mask_;
+    uint64_t hits_;
+    uint64_t misses_;
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_ADDRESS_CACHE_H
@@ -0,0 +1,47 @@
+/**
+ * Bump allocator for short-lived formatting buffers
+ */
+
+#include "arena.h"
+
+namespace whisper {
+namespace crypto {
+
+Arena::Arena(size_t blockSize)
+    : blockIndex_(0), offset_(0), blockSize_(blockSize ? blockSize : 1) {
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    while (true) {
+        if (blockIndex_ < blocks_.size()) {
+            Block& block = blocks_[blockIndex_];
+            size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (aligned + size <= block.size) {
+                offset_ = aligned + size;
+                return block.data.get() + aligned;
+            }
+            // Exhausted: move on to the next (or a fresh) block
+            ++blockIndex_;
+            offset_ = 0;
+            continue;
+        }
+        size_t blockSize = blockSize_;
+        if (size + alignment > blockSize) {
+            blockSize = size + alignment;  // oversized request
+        }
+        blocks_.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[blockSize]), blockSize});
+    }
+}
+
+void Arena::reset() {
+    blockIndex_ = 0;
+    offset_ = 0;
+}
+
+void Arena::rewind(Marker marker) {
+    blockIndex_ = marker.block;
+    offset_ = marker.offset;
+}
+
+} // namespace crypto
+} // namespace whisper
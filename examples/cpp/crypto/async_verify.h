@@ -0,0 +1,186 @@
+#ifndef WHISPER_CRYPTO_ASYNC_VERIFY_H
+#define WHISPER_CRYPTO_ASYNC_VERIFY_H
+
+// Opt-in coroutine front-end for signature verification. Header-only
+// and only usable from C++20 translation units; C++17 consumers of
+// secp256k1_wrapper.h are unaffected (the library itself stays C++17).
+
+#if defined(__cpp_impl_coroutine)
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "secp256k1_wrapper.h"
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Awaitable, batching signature verifier
+ *
+ * co_await verifier.verify(pub, hash, sig) suspends the calling
+ * coroutine, parks the request, and resumes with the boolean result
+ * once a dedicated verification thread has processed it. Requests
+ * that arrive within the coalescing window are drained into a single
+ * verifyBatch call, so connection handlers never block an executor
+ * thread on a full verification.
+ *
+ * Coroutines are resumed on the verification thread; hop back to your
+ * executor after the co_await if you need thread affinity.
+ */
+class AsyncVerifier {
+public:
+    /**
+     * @brief Start the verification thread
+     * @param window Coalescing window before a partial batch runs
+     * @param maxBatch Batch size that triggers an immediate run
+     */
+    explicit AsyncVerifier(
+        std::chrono::microseconds window = std::chrono::microseconds(50),
+        size_t maxBatch = 64
+    )
+        : window_(window), maxBatch_(maxBatch), stopping_(false) {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~AsyncVerifier() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    AsyncVerifier(const AsyncVerifier&) = delete;
+    AsyncVerifier& operator=(const AsyncVerifier&) = delete;
+
+    class Awaitable {
+    public:
+        Awaitable(AsyncVerifier& verifier,
+                  const uint8_t* publicKey,
+                  const uint8_t* messageHash,
+                  const uint8_t* signature)
+            : verifier_(verifier),
+              publicKey_(publicKey),
+              messageHash_(messageHash),
+              signature_(signature),
+              result_(false) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            verifier_.submit(this, handle);
+        }
+
+        bool await_resume() const noexcept { return result_; }
+
+    private:
+        friend class AsyncVerifier;
+        AsyncVerifier& verifier_;
+        const uint8_t* publicKey_;
+        const uint8_t* messageHash_;
+        const uint8_t* signature_;
+        bool result_;
+    };
+
+    /**
+     * @brief Build the awaitable for one verification
+     *
+     * Buffers must stay valid until the co_await completes.
+     */
+    Awaitable verify(
+        const uint8_t* publicKey,
+        const uint8_t* messageHash,
+        const uint8_t* signature
+    ) {
+        return Awaitable(*this, publicKey, messageHash, signature);
+    }
+
+private:
+    struct Pending {
+        Awaitable* awaitable;
+        std::coroutine_handle<> handle;
+    };
+
+    void submit(Awaitable* awaitable, std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(Pending{awaitable, handle});
+        }
+        cv_.notify_one();
+    }
+
+    void run() {
+        SECP256k1Wrapper wrapper;
+        std::vector<Pending> batch;
+        std::vector<VerifyJob> jobs;
+        std::vector<uint64_t> results;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                if (stopping_) {
+                    return;
+                }
+                continue;
+            }
+
+            // Coalesce: give the window a chance to fill the batch
+            if (pending_.size() < maxBatch_ && !stopping_) {
+                cv_.wait_for(lock, window_, [this] {
+                    return stopping_ || pending_.size() >= maxBatch_;
+                });
+            }
+
+            batch.clear();
+            batch.swap(pending_);
+            lock.unlock();
+
+            jobs.clear();
+            for (const Pending& p : batch) {
+                jobs.push_back(VerifyJob{
+                    p.awaitable->publicKey_,
+                    p.awaitable->messageHash_,
+                    p.awaitable->signature_
+                });
+            }
+            results.assign((batch.size() + 63) / 64, 0);
+            wrapper.verifyBatch(jobs.data(), batch.size(), results.data());
+
+            for (size_t i = 0; i < batch.size(); ++i) {
+                batch[i].awaitable->result_ =
+                    (results[i / 64] >> (i % 64)) & 1;
+                batch[i].handle.resume();
+            }
+
+            lock.lock();
+            if (stopping_ && pending_.empty()) {
+                return;
+            }
+        }
+    }
+
+    std::chrono::microseconds window_;
+    size_t maxBatch_;
+    bool stopping_;
+    std::vector<Pending> pending_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#else
+#error "async_verify.h requires C++20 coroutine support"
+#endif // __cpp_impl_coroutine
+
+#endif // WHISPER_CRYPTO_ASYNC_VERIFY_H
@@ -0,0 +1,58 @@
+/**
+ * Runtime CPU-feature dispatch for crypto kernels
+ *
+ * ISA-specific kernels live in their own translation units compiled
+ * with the matching target flags (e.g. keccak256_batch_avx2.cpp with
+ * -mavx2); this file probes the running CPU once and hands out
+ * resolved function pointers.
+ */
+
+#include "cpu_dispatch.h"
+#include "keccak256_f.h"
+
+namespace whisper {
+namespace crypto {
+
+namespace {
+
+struct Resolved {
+    const char* name;
+    detail::HashBatch4Fn hashBatch4;
+};
+
+Resolved resolve() {
+    Resolved r;
+    r.name = "scalar";
+    r.hashBatch4 = nullptr;
+
+#if defined(WHISPER_HAVE_KECCAK_X4) && (defined(__x86_64__) || defined(__i386__))
+    if (__builtin_cpu_supports("avx2")) {
+        r.name = "avx2";
+        r.hashBatch4 = &detail::hashBatch4;
+    }
+#endif
+
+    return r;
+}
+
+const Resolved& resolved() {
+    static const Resolved r = resolve();
+    return r;
+}
+
+} // namespace
+
+const char* activeImplementation() {
+    return resolved().name;
+}
+
+namespace detail {
+
+HashBatch4Fn hashBatch4Kernel() {
+    return resolved().hashBatch4;
+}
+
+} // namespace detail
+
+} // namespace crypto
+} // namespace whisper
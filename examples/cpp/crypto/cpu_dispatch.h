@@ -0,0 +1,37 @@
+#ifndef WHISPER_CRYPTO_CPU_DISPATCH_H
+#define WHISPER_CRYPTO_CPU_DISPATCH_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Name of the crypto kernel set selected for this host
+ *
+ * Resolved once from CPUID (x86) or getauxval (ARM) on first call;
+ * intended for ops dashboards to confirm which implementation is live
+ * per machine. Examples: "scalar", "avx2".
+ */
+const char* activeImplementation();
+
+namespace detail {
+
+/// Signature of a 4-lane Keccak batch kernel (see keccak256_f.h)
+using HashBatch4Fn = void (*)(const uint8_t* const[4], const size_t[4], uint8_t*);
+
+/**
+ * @brief SIMD batch kernel for this host, or null for scalar-only
+ *
+ * The pointer is resolved exactly once; callers dispatch through it
+ * without re-querying CPU features per call.
+ */
+HashBatch4Fn hashBatch4Kernel();
+
+} // namespace detail
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_CPU_DISPATCH_H
@@ -0,0 +1,177 @@
+/**
+ * Per-thread ChaCha20 CSPRNG with pooled OS entropy
+ */
+
+#include "entropy.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace whisper {
+namespace crypto {
+namespace entropy {
+
+namespace {
+
+// Reseed after this much keystream has been handed out
+constexpr uint64_t RESEED_INTERVAL = 1u << 20;
+
+inline uint32_t rotl32(uint32_t v, int s) {
+    return (v << s) | (v >> (32 - s));
+}
+
+inline void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl32(d, 16);
+    c += d; b ^= c; b = rotl32(b, 12);
+    a += b; d ^= a; d = rotl32(d, 8);
+    c += d; b ^= c; b = rotl32(b, 7);
+}
+
+void chachaBlock(const uint32_t state[16], uint8_t out[64]) {
+    uint32_t x[16];
+    std::memcpy(x, state, sizeof(x));
+    for (int i = 0; i < 10; ++i) {
+        quarterRound(x[0], x[4], x[8], x[12]);
+        quarterRound(x[1], x[5], x[9], x[13]);
+        quarterRound(x[2], x[6], x[10], x[14]);
+        quarterRound(x[3], x[7], x[11], x[15]);
+        quarterRound(x[0], x[5], x[10], x[15]);
+        quarterRound(x[1], x[6], x[11], x[12]);
+        quarterRound(x[2], x[7], x[8], x[13]);
+        quarterRound(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t word = x[i] + state[i];
+        std::memcpy(out + i * 4, &word, 4);
+    }
+}
+
+void osEntropy(uint8_t* out, size_t length) {
+#if defined(__linux__)
+    size_t done = 0;
+    while (done < length) {
+        const ssize_t got = getrandom(out + done, length - done, 0);
+        if (got > 0) {
+            done += static_cast<size_t>(got);
+        }
+    }
+#else
+    FILE* f = std::fopen("/dev/urandom", "rb");
+    if (f) {
+        if (std::fread(out, 1, length, f) != length) {
+            // Keep whatever was read; RDRAND mixing still applies
+        }
+        std::fclose(f);
+    }
+#endif
+}
+
+#if defined(__x86_64__)
+__attribute__((target("rdrnd")))
+bool rdrandWord(uint64_t* out) {
+    unsigned long long value = 0;
+    const int ok = _rdrand64_step(&value);
+    *out = value;
+    return ok == 1;
+}
+
+bool haveRdrand() {
+    static const bool have = __builtin_cpu_supports("rdrnd");
+    return have;
+}
+#endif
+
+struct Generator {
+    uint32_t state[16];
+    uint8_t block[64];
+    size_t blockUsed;
+    uint64_t produced;
+    bool seeded;
+
+    Generator() : blockUsed(64), produced(0), seeded(false) {}
+
+    void seed() {
+        static const char sigma[16] = {
+            'e','x','p','a','n','d',' ','3','2','-','b','y','t','e',' ','k'
+        };
+        std::memcpy(state, sigma, 16);
+
+        uint8_t key[40];
+        osEntropy(key, sizeof(key));
+
+#if defined(__x86_64__)
+        // Fold hardware randomness into the OS seed when present
+        if (haveRdrand()) {
+            for (int i = 0; i < 5; ++i) {
+                uint64_t word;
+                if (rdrandWord(&word)) {
+                    uint64_t current;
+                    std::memcpy(&current, key + i * 8, 8);
+                    current ^= word;
+                    std::memcpy(key + i * 8, &current, 8);
+                }
+            }
+        }
+#endif
+
+        std::memcpy(state + 4, key, 32);        // key
+        state[12] = 0;                          // counter
+        std::memcpy(state + 13, key + 32, 8);   // nonce
+        state[15] = 0;
+
+        std::memset(key, 0, sizeof(key));
+        blockUsed = 64;
+        produced = 0;
+        seeded = true;
+    }
+
+    void fill(uint8_t* out, size_t length) {
+        if (!seeded || produced > RESEED_INTERVAL) {
+            seed();
+        }
+        while (length > 0) {
+            if (blockUsed == 64) {
+                chachaBlock(state, block);
+                ++state[12];
+                if (state[12] == 0) {
+                    ++state[13];
+                }
+                blockUsed = 0;
+            }
+            size_t take = 64 - blockUsed;
+            if (take > length) {
+                take = length;
+            }
+            std::memcpy(out, block + blockUsed, take);
+            std::memset(block + blockUsed, 0, take);  // no backtracking
+            blockUsed += take;
+            out += take;
+            length -= take;
+            produced += take;
+        }
+    }
+};
+
+thread_local Generator tlsGenerator;
+
+} // namespace
+
+void randomBytes(uint8_t* out, size_t length) {
+    tlsGenerator.fill(out, length);
+}
+
+void reseed() {
+    tlsGenerator.seed();
+}
+
+} // namespace entropy
+} // namespace crypto
+} // namespace whisper
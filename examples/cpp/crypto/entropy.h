@@ -0,0 +1,37 @@
+#ifndef WHISPER_CRYPTO_ENTROPY_H
+#define WHISPER_CRYPTO_ENTROPY_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Pooled cryptographic randomness
+ *
+ * Each thread owns a ChaCha20-based generator seeded from the OS
+ * (getrandom, /dev/urandom fallback) with hardware RDRAND mixed in
+ * where available. Output is drawn from the keystream and the
+ * generator reseeds itself after a fixed output budget, so bursts of
+ * key generation cost one syscall per reseed interval rather than one
+ * random_device construction per key.
+ */
+namespace entropy {
+
+/**
+ * @brief Fill a buffer with cryptographically strong random bytes
+ */
+void randomBytes(uint8_t* out, size_t length);
+
+/**
+ * @brief Force an immediate reseed of the calling thread's generator
+ */
+void reseed();
+
+} // namespace entropy
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_ENTROPY_H
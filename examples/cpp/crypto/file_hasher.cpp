@@ -0,0 +1,130 @@
+/**
+ * Streaming file hasher with overlapped reads
+ *
+ * A reader thread fills buffers ahead of the hashing thread through a
+ * small free-list/ready-list hand-off; buffers come back in file order
+ * because the reader issues preads sequentially. The buffer arena is
+ * allocated once and reused across files.
+ */
+
+#include "file_hasher.h"
+#include "keccak256.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace whisper {
+namespace crypto {
+
+FileHasher::FileHasher(size_t bufferSize, size_t bufferCount)
+    : bufferSize_(bufferSize ? bufferSize : Keccak256::RATE_BYTES),
+      bufferCount_(bufferCount >= 2 ? bufferCount : 2),
+      arena_(new uint8_t[bufferSize_ * bufferCount_]) {
+}
+
+FileHasher::~FileHasher() {
+    delete[] arena_;
+}
+
+bool FileHasher::hashFile(const char* path, uint8_t digest[32]) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    struct Chunk {
+        uint8_t* data;
+        size_t length;
+    };
+
+    std::mutex mutex;
+    std::condition_variable readyCv;
+    std::condition_variable freeCv;
+    std::queue<Chunk> ready;     // filled, in file order
+    std::queue<uint8_t*> free_;  // available to the reader
+    bool done = false;
+    bool failed = false;
+
+    for (size_t i = 0; i < bufferCount_; ++i) {
+        free_.push(arena_ + i * bufferSize_);
+    }
+
+    // Reader: keep buffers in flight ahead of the hasher
+    std::thread reader([&] {
+        off_t offset = 0;
+        for (;;) {
+            uint8_t* buffer;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                freeCv.wait(lock, [&] { return !free_.empty(); });
+                buffer = free_.front();
+                free_.pop();
+            }
+
+            ssize_t n = pread(fd, buffer, bufferSize_, offset);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (n < 0) {
+                failed = true;
+                done = true;
+            } else if (n == 0) {
+                done = true;
+            } else {
+                offset += n;
+                ready.push({buffer, static_cast<size_t>(n)});
+            }
+            readyCv.notify_one();
+            if (done) {
+                return;
+            }
+        }
+    });
+
+    // Hasher: drain completed buffers through the bulk update path
+    Keccak256 hasher;
+    for (;;) {
+        Chunk chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            readyCv.wait(lock, [&] { return !ready.empty() || done; });
+            if (ready.empty()) {
+                break;
+            }
+            chunk = ready.front();
+            ready.pop();
+        }
+        hasher.update(chunk.data, chunk.length);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free_.push(chunk.data);
+        }
+        freeCv.notify_one();
+    }
+
+    reader.join();
+    ::close(fd);
+    if (failed) {
+        return false;
+    }
+    hasher.finalize(digest);
+    return true;
+#else
+    (void)path;
+    (void)digest;
+    return false;
+#endif
+}
+
+} // namespace crypto
+} // namespace whisper
@@ -0,0 +1,100 @@
+/**
+ * Table-driven hex codec
+ *
+ * Encoding expands each byte through a 512-byte pair table with a
+ * single 16-bit store; decoding maps characters through a 256-entry
+ * nibble table whose invalid slots poison the result, so validity is
+ * one branch per byte pair instead of per character.
+ */
+
+#include "hex.h"
+
+#include <cstring>
+
+namespace whisper {
+namespace crypto {
+namespace hex {
+
+namespace {
+
+struct EncodeTable {
+    char pairs[256][2];
+};
+
+constexpr EncodeTable makeEncodeTable() {
+    EncodeTable t{};
+    const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < 256; ++i) {
+        t.pairs[i][0] = digits[i >> 4];
+        t.pairs[i][1] = digits[i & 0x0F];
+    }
+    return t;
+}
+
+constexpr EncodeTable ENCODE = makeEncodeTable();
+
+struct DecodeTable {
+    uint8_t nibble[256];
+};
+
+constexpr uint8_t INVALID_NIBBLE = 0xFF;
+
+constexpr DecodeTable makeDecodeTable() {
+    DecodeTable t{};
+    for (int i = 0; i < 256; ++i) {
+        t.nibble[i] = INVALID_NIBBLE;
+    }
+    for (int i = 0; i <= 9; ++i) {
+        t.nibble['0' + i] = static_cast<uint8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        t.nibble['a' + i] = static_cast<uint8_t>(10 + i);
+        t.nibble['A' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return t;
+}
+
+constexpr DecodeTable DECODE = makeDecodeTable();
+
+} // namespace
+
+void encode(const uint8_t* bytes, size_t length, char* out) {
+    for (size_t i = 0; i < length; ++i) {
+        std::memcpy(out + i * 2, ENCODE.pairs[bytes[i]], 2);
+    }
+}
+
+std::string_view encodeView(const uint8_t* bytes, size_t length, char* storage) {
+    encode(bytes, length, storage);
+    return std::string_view(storage, length * 2);
+}
+
+std::string_view encodeView(const uint8_t* bytes, size_t length, Arena& arena) {
+    char* storage = static_cast<char*>(arena.allocate(length * 2, 1));
+    return encodeView(bytes, length, storage);
+}
+
+std::string encodeString(const uint8_t* bytes, size_t length) {
+    std::string result(length * 2, '\0');
+    encode(bytes, length, &result[0]);
+    return result;
+}
+
+bool decode(const char* in, size_t length, uint8_t* out) {
+    if (length % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i += 2) {
+        const uint8_t hi = DECODE.nibble[static_cast<uint8_t>(in[i])];
+        const uint8_t lo = DECODE.nibble[static_cast<uint8_t>(in[i + 1])];
+        if ((hi | lo) == INVALID_NIBBLE) {
+            return false;
+        }
+        out[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+} // namespace hex
+} // namespace crypto
+} // namespace whisper
@@ -0,0 +1,61 @@
+#ifndef WHISPER_CRYPTO_HEX_H
+#define WHISPER_CRYPTO_HEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "arena.h"
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Zero-allocation hex codec
+ *
+ * Table-driven encode/decode into caller-provided buffers; nothing in
+ * this module allocates or touches locales, unlike the ostringstream
+ * formatting it replaces.
+ */
+namespace hex {
+
+/**
+ * @brief Encode bytes as lowercase hex into a caller buffer
+ * @param out Receives 2 * length characters (no terminator)
+ */
+void encode(const uint8_t* bytes, size_t length, char* out);
+
+/**
+ * @brief Encode into caller storage and return a view over it
+ * @param storage Must hold at least 2 * length characters
+ */
+std::string_view encodeView(const uint8_t* bytes, size_t length, char* storage);
+
+/**
+ * @brief Encode into arena storage and return a view over it
+ *
+ * The view lives until the arena is rewound past the allocation.
+ */
+std::string_view encodeView(const uint8_t* bytes, size_t length, Arena& arena);
+
+/**
+ * @brief Encode into a freshly allocated string (convenience path)
+ */
+std::string encodeString(const uint8_t* bytes, size_t length);
+
+/**
+ * @brief Decode a hex string into a caller buffer
+ * @param in Hex characters, upper or lower case, even count
+ * @param length Number of input characters
+ * @param out Receives length / 2 bytes
+ * @return false on odd length or any non-hex character
+ */
+bool decode(const char* in, size_t length, uint8_t* out);
+
+} // namespace hex
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_HEX_H
@@ -0,0 +1,140 @@
+/**
+ * Pipelined hash-then-verify engine for message ingest
+ *
+ * Hashing threads drain the intake ring into the verify ring; verifier
+ * threads drain the verify ring and fire the completion callback. Both
+ * rings are bounded, so a slow verification stage backpressures all the
+ * way to submit() instead of growing an unbounded queue.
+ */
+
+#include "ingest_pipeline.h"
+#include "keccak256.h"
+#include "secp256k1_wrapper.h"
+
+namespace whisper {
+namespace crypto {
+
+IngestPipeline::Ring::Ring(size_t capacity) : slots_(capacity ? capacity : 1) {
+}
+
+void IngestPipeline::Ring::push(Message&& message) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return count_ < slots_.size(); });
+    slots_[(head_ + count_) % slots_.size()] = std::move(message);
+    ++count_;
+    notEmpty_.notify_one();
+}
+
+bool IngestPipeline::Ring::pop(Message& message) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return count_ > 0 || closed_; });
+    if (count_ == 0) {
+        return false;
+    }
+    message = std::move(slots_[head_]);
+    head_ = (head_ + 1) % slots_.size();
+    --count_;
+    notFull_.notify_one();
+    return true;
+}
+
+void IngestPipeline::Ring::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notEmpty_.notify_all();
+}
+
+IngestPipeline::IngestPipeline(
+    Callback onComplete,
+    size_t hashThreads,
+    size_t verifyThreads,
+    size_t ringCapacity
+)
+    : onComplete_(std::move(onComplete)),
+      intakeRing_(ringCapacity),
+      verifyRing_(ringCapacity) {
+    if (hashThreads == 0) {
+        hashThreads = 1;
+    }
+    if (verifyThreads == 0) {
+        size_t hw = std::thread::hardware_concurrency();
+        verifyThreads = hw > hashThreads ? hw - hashThreads : 1;
+    }
+    hashThreads_.reserve(hashThreads);
+    for (size_t i = 0; i < hashThreads; ++i) {
+        hashThreads_.emplace_back([this] { hashLoop(); });
+    }
+    verifyThreads_.reserve(verifyThreads);
+    for (size_t i = 0; i < verifyThreads; ++i) {
+        verifyThreads_.emplace_back([this] { verifyLoop(); });
+    }
+}
+
+IngestPipeline::~IngestPipeline() {
+    flush();
+    intakeRing_.close();
+    for (auto& thread : hashThreads_) {
+        thread.join();
+    }
+    // Only close the verify ring once every hashing thread has drained,
+    // so nothing in flight is dropped
+    verifyRing_.close();
+    for (auto& thread : verifyThreads_) {
+        thread.join();
+    }
+}
+
+uint64_t IngestPipeline::submit(
+    const uint8_t* payload,
+    size_t length,
+    const uint8_t* publicKey,
+    const uint8_t* signature
+) {
+    Message message;
+    message.sequence = nextSequence_.fetch_add(1, std::memory_order_relaxed);
+    message.payload = payload;
+    message.length = length;
+    message.publicKey = publicKey;
+    message.signature = signature;
+    uint64_t sequence = message.sequence;
+    intakeRing_.push(std::move(message));
+    return sequence;
+}
+
+void IngestPipeline::flush() {
+    uint64_t target = nextSequence_.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(progressMutex_);
+    progressCv_.wait(lock, [this, target] { return completed_ >= target; });
+}
+
+void IngestPipeline::hashLoop() {
+    Keccak256 hasher;
+    Message message;
+    while (intakeRing_.pop(message)) {
+        hasher.reset();
+        hasher.update(message.payload, message.length);
+        hasher.finalize(message.hash);
+        verifyRing_.push(std::move(message));
+    }
+}
+
+void IngestPipeline::verifyLoop() {
+    SECP256k1Wrapper wrapper;
+    Message message;
+    while (verifyRing_.pop(message)) {
+        bool verified = wrapper.verify(message.publicKey, message.hash, message.signature);
+        complete(message.sequence, verified);
+    }
+}
+
+void IngestPipeline::complete(uint64_t sequence, bool verified) {
+    if (onComplete_) {
+        onComplete_(sequence, verified);
+    }
+    std::lock_guard<std::mutex> lock(progressMutex_);
+    ++completed_;
+    progressCv_.notify_all();
+}
+
+} // namespace crypto
+} // namespace whisper
@@ -0,0 +1,137 @@
+#ifndef WHISPER_CRYPTO_INGEST_PIPELINE_H
+#define WHISPER_CRYPTO_INGEST_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Two-stage hash-then-verify pipeline for message ingest
+ *
+ * Ingest is two dependent stages with very different costs: Keccak-256
+ * over the payload, then an ECDSA verify over the digest. Running them
+ * inline serializes both on one core; the pipeline instead runs
+ * dedicated hashing threads and verifier threads connected by bounded
+ * rings, so each stage stays hot in its own working set and both make
+ * progress concurrently.
+ *
+ * submit() blocks when the intake ring is full (backpressure), and the
+ * verify ring's bound propagates that backpressure upstream when
+ * verification is the slower stage. flush() is a barrier that returns
+ * once every message submitted before it has completed.
+ *
+ * Payload, public key and signature buffers must stay valid until the
+ * completion callback fires for that message; the pipeline does not
+ * copy them. The callback runs on a verifier thread and should be
+ * cheap.
+ */
+class IngestPipeline {
+public:
+    /// Completion callback: sequence returned by submit(), verify result
+    using Callback = std::function<void(uint64_t sequence, bool verified)>;
+
+    /**
+     * @brief Start the pipeline
+     * @param onComplete Called once per submitted message
+     * @param hashThreads Hashing stage width (0 selects 1)
+     * @param verifyThreads Verification stage width (0 selects
+     *        hardware_concurrency minus the hashing threads)
+     * @param ringCapacity Capacity of each inter-stage ring
+     */
+    explicit IngestPipeline(
+        Callback onComplete,
+        size_t hashThreads = 0,
+        size_t verifyThreads = 0,
+        size_t ringCapacity = 1024
+    );
+    ~IngestPipeline();
+
+    IngestPipeline(const IngestPipeline&) = delete;
+    IngestPipeline& operator=(const IngestPipeline&) = delete;
+
+    /**
+     * @brief Submit one message for hash + verify
+     *
+     * Blocks while the intake ring is full.
+     *
+     * @param payload Message payload to hash
+     * @param length Payload length
+     * @param publicKey 64-byte public key
+     * @param signature 64-byte compact signature
+     * @return Sequence number passed to the completion callback
+     */
+    uint64_t submit(
+        const uint8_t* payload,
+        size_t length,
+        const uint8_t* publicKey,
+        const uint8_t* signature
+    );
+
+    /**
+     * @brief Wait until everything submitted so far has completed
+     */
+    void flush();
+
+    size_t hashThreadCount() const { return hashThreads_.size(); }
+    size_t verifyThreadCount() const { return verifyThreads_.size(); }
+
+private:
+    struct Message {
+        uint64_t sequence;
+        const uint8_t* payload;
+        size_t length;
+        const uint8_t* publicKey;
+        const uint8_t* signature;
+        uint8_t hash[32];
+    };
+
+    /**
+     * Bounded MPMC ring; push blocks while full, pop blocks while
+     * empty unless the pipeline is draining.
+     */
+    class Ring {
+    public:
+        explicit Ring(size_t capacity);
+
+        void push(Message&& message);
+        bool pop(Message& message);
+        void close();
+
+    private:
+        std::vector<Message> slots_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+        bool closed_ = false;
+        std::mutex mutex_;
+        std::condition_variable notFull_;
+        std::condition_variable notEmpty_;
+    };
+
+    void hashLoop();
+    void verifyLoop();
+    void complete(uint64_t sequence, bool verified);
+
+    Callback onComplete_;
+    Ring intakeRing_;
+    Ring verifyRing_;
+    std::vector<std::thread> hashThreads_;
+    std::vector<std::thread> verifyThreads_;
+
+    std::atomic<uint64_t> nextSequence_{0};
+    std::mutex progressMutex_;
+    std::condition_variable progressCv_;
+    uint64_t completed_ = 0;
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_INGEST_PIPELINE_H
@@ -4,25 +4,16 @@
  */
 
 #include "keccak256.h"
+#include "keccak256_f.h"
+#include "arena.h"
+#include "cpu_dispatch.h"
+#include "hex.h"
+#include "stats.h"
 #include <cstring>
-#include <iomanip>
-#include <sstream>
 
 namespace whisper {
 namespace crypto {
 
-// Keccak round constants
-static const uint64_t RC[24] = {
-    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
-    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
-    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
-    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
-    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
-    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
-    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
-    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
-};
-
 Keccak256::Keccak256() {
     reset();
 }
@@ -31,36 +22,82 @@ void Keccak256::reset() {
     std::memset(state, 0, sizeof(state));
     std::memset(buffer, 0, sizeof(buffer));
     bufferSize = 0;
+    squeezeOffset = 0;
+    squeezing = false;
 }
 
 void Keccak256::update(const uint8_t* data, size_t length) {
-    for (size_t i = 0; i < length; ++i) {
-        buffer[bufferSize++] = data[i];
+    WHISPER_STATS_SCOPE(KeccakUpdate);
+    // Top up a partially filled buffer first
+    if (bufferSize > 0) {
+        size_t take = RATE_BYTES - bufferSize;
+        if (take > length) {
+            take = length;
+        }
+        std::memcpy(buffer + bufferSize, data, take);
+        bufferSize += take;
+        data += take;
+        length -= take;
 
         if (bufferSize == RATE_BYTES) {
             absorb();
             bufferSize = 0;
         }
     }
+
+    // Bulk path: absorb whole rate blocks straight from the caller's
+    // memory, skipping the intermediate buffer copy entirely
+    while (length >= RATE_BYTES) {
+        detail::xorBlockIntoState(state, data);
+        keccakF();
+        data += RATE_BYTES;
+        length -= RATE_BYTES;
+    }
+
+    // Stash the tail for the next update() or finalize()
+    if (length > 0) {
+        std::memcpy(buffer, data, length);
+        bufferSize = length;
+    }
 }
 
 void Keccak256::finalize(uint8_t* hash) {
-    // Padding
-    buffer[bufferSize++] = 0x01;
+    WHISPER_STATS_SCOPE(KeccakFinalize);
+    squeeze(hash, HASH_SIZE);
+}
 
-    while (bufferSize < RATE_BYTES) {
-        buffer[bufferSize++] = 0x00;
-    }
+void Keccak256::squeeze(uint8_t* out, size_t length) {
+    if (!squeezing) {
+        // Padding closes the absorb phase
+        buffer[bufferSize++] = 0x01;
 
-    buffer[RATE_BYTES - 1] |= 0x80;
+        while (bufferSize < RATE_BYTES) {
+            buffer[bufferSize++] = 0x00;
+        }
 
-    absorb();
+        buffer[RATE_BYTES - 1] |= 0x80;
 
-    // Squeeze
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            hash[i * 8 + j] = (state[i] >> (j * 8)) & 0xFF;
+        absorb();
+        squeezing = true;
+        squeezeOffset = 0;
+    }
+
+    while (length > 0) {
+        if (squeezeOffset == RATE_BYTES) {
+            keccakF();
+            squeezeOffset = 0;
+        }
+        size_t take = RATE_BYTES - squeezeOffset;
+        if (take > length) {
+            take = length;
+        }
+        for (size_t i = 0; i < take; ++i) {
+            const size_t pos = squeezeOffset + i;
+            out[i] = static_cast<uint8_t>(state[pos >> 3] >> (8 * (pos & 7)));
         }
+        squeezeOffset += take;
+        out += take;
+        length -= take;
     }
 }
 
@@ -74,76 +111,54 @@ std::string Keccak256::hash(const std::string& input) {
     return bytesToHex(hash, 32);
 }
 
-void Keccak256::absorb() {
-    // XOR input into state
-    for (size_t i = 0; i < RATE_BYTES / 8; ++i) {
-        uint64_t value = 0;
-        for (int j = 0; j < 8; ++j) {
-            value |= static_cast<uint64_t>(buffer[i * 8 + j]) << (j * 8);
-        }
-        state[i] ^= value;
-    }
-
-    keccakF();
+std::string_view Keccak256::hash(const std::string& input, Arena& arena) {
+    return hash(input, static_cast<char*>(arena.allocate(2 * HASH_SIZE, 1)));
 }
 
-void Keccak256::keccakF() {
-    // Keccak-f[1600] permutation (simplified version for demonstration)
-    for (int round = 0; round < 24; ++round) {
-        // Theta
-        uint64_t C[5], D[5];
-        for (int x = 0; x < 5; ++x) {
-            C[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
-        }
-
-        for (int x = 0; x < 5; ++x) {
-            D[x] = C[(x + 4) % 5] ^ rotateLeft(C[(x + 1) % 5], 1);
-        }
-
-        for (int x = 0; x < 5; ++x) {
-            for (int y = 0; y < 5; ++y) {
-                state[x + 5 * y] ^= D[x];
-            }
-        }
+std::string_view Keccak256::hash(const std::string& input, char* storage) {
+    Keccak256 hasher;
+    hasher.update(reinterpret_cast<const uint8_t*>(input.data()), input.length());
 
-        // Rho and Pi (simplified)
-        uint64_t temp[25];
-        std::memcpy(temp, state, sizeof(state));
+    uint8_t hash[HASH_SIZE];
+    hasher.finalize(hash);
 
-        for (int x = 0; x < 5; ++x) {
-            for (int y = 0; y < 5; ++y) {
-                int newX = y;
-                int newY = (2 * x + 3 * y) % 5;
-                state[newX + 5 * newY] = rotateLeft(temp[x + 5 * y], ((x + 3 * y) * (x + 3 * y + 1) / 2) % 64);
-            }
-        }
+    return hex::encodeView(hash, HASH_SIZE, storage);
+}
 
-        // Chi
-        std::memcpy(temp, state, sizeof(state));
-        for (int y = 0; y < 5; ++y) {
-            for (int x = 0; x < 5; ++x) {
-                state[x + 5 * y] = temp[x + 5 * y] ^ ((~temp[(x + 1) % 5 + 5 * y]) & temp[(x + 2) % 5 + 5 * y]);
-            }
+void Keccak256::hashBatch(
+    const uint8_t* const* inputs,
+    const size_t* lengths,
+    size_t count,
+    uint8_t* outputs
+) {
+    size_t i = 0;
+
+    const detail::HashBatch4Fn kernel = detail::hashBatch4Kernel();
+    if (kernel != nullptr) {
+        for (; i + 4 <= count; i += 4) {
+            kernel(inputs + i, lengths + i, outputs + i * HASH_SIZE);
         }
+    }
 
-        // Iota
-        state[0] ^= RC[round];
+    // Scalar path for the remainder (and for CPUs without SIMD lanes)
+    for (; i < count; ++i) {
+        Keccak256 hasher;
+        hasher.update(inputs[i], lengths[i]);
+        hasher.finalize(outputs + i * HASH_SIZE);
     }
 }
 
-uint64_t Keccak256::rotateLeft(uint64_t value, int shift) {
-    return (value << shift) | (value >> (64 - shift));
+void Keccak256::absorb() {
+    detail::xorBlockIntoState(state, buffer);
+    keccakF();
 }
 
-std::string Keccak256::bytesToHex(const uint8_t* bytes, size_t length) {
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0');
-
-    for (size_t i = 0; i < length; ++i) {
-        oss << std::setw(2) << static_cast<int>(bytes[i]);
-    }
+void Keccak256::keccakF() {
+    detail::keccakPermute(state);
+}
 
-    return oss.str();
+std::string Keccak256::bytesToHex(const uint8_t* bytes, size_t length) {
+    return hex::encodeString(bytes, length);
 }
 
 } // namespace crypto
@@ -1,12 +1,18 @@
 #ifndef WHISPER_CRYPTO_KECCAK256_H
 #define WHISPER_CRYPTO_KECCAK256_H
 
+#include <array>
 #include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "keccak256_f.h"
 
 namespace whisper {
 namespace crypto {
 
+class Arena;
+
 /**
  * @brief Keccak-256 hash implementation
  *
@@ -14,6 +20,11 @@ namespace crypto {
  * - Address generation
  * - Transaction hashing
  * - Message signing
+ *
+ * The hasher is a plain value type: its midstate (sponge state plus
+ * pending buffer) copies freely, so a shared message prefix can be
+ * absorbed once and fork()ed per message, paying only for each unique
+ * suffix.
  */
 class Keccak256 {
 public:
@@ -41,6 +52,30 @@ public:
      */
     void finalize(uint8_t* hash);
 
+    /**
+     * @brief Squeeze arbitrary output from the sponge (XOF mode)
+     *
+     * The first call pads and closes the absorb phase; every call then
+     * emits the next length bytes of the output stream, permuting only
+     * when a rate block is exhausted. One absorbed master secret can
+     * thus yield keys, nonces and IDs in a single sponge pass.
+     *
+     * Keccak's 0x01 padding is kept (this is not SHAKE's 0x1F), so the
+     * first 32 squeezed bytes equal finalize()'s digest. update() must
+     * not be called again until reset().
+     */
+    void squeeze(uint8_t* out, size_t length);
+
+    /**
+     * @brief Snapshot the current midstate
+     *
+     * Returns an independent hasher that continues from everything
+     * absorbed so far; this hasher is unaffected. Typical use: absorb
+     * a per-epoch envelope header once, then fork per message and
+     * update/finalize only the suffix.
+     */
+    Keccak256 fork() const { return *this; }
+
     /**
      * @brief Compute hash of a string
      * @param input Input string
@@ -48,17 +83,109 @@ public:
      */
     static std::string hash(const std::string& input);
 
+    /**
+     * @brief Compute hash into arena-backed hex storage
+     *
+     * Allocation-free variant of hash(): the hex digest is bumped out
+     * of the arena and the view lives until the arena is rewound past
+     * it.
+     */
+    static std::string_view hash(const std::string& input, Arena& arena);
+
+    /**
+     * @brief Compute hash into caller storage
+     * @param storage Must hold at least 64 characters
+     */
+    static std::string_view hash(const std::string& input, char* storage);
+
+    /**
+     * @brief Hash many independent messages in one call
+     *
+     * Processes messages in groups of four through a SIMD lane-parallel
+     * Keccak-f[1600] kernel when the CPU supports it (AVX2), falling
+     * back to the scalar path otherwise. Results are identical to
+     * calling update()/finalize() per message.
+     *
+     * @param inputs Array of count input pointers
+     * @param lengths Array of count input lengths
+     * @param count Number of messages
+     * @param outputs Output buffer (count * 32 bytes)
+     */
+    static void hashBatch(
+        const uint8_t* const* inputs,
+        const size_t* lengths,
+        size_t count,
+        uint8_t* outputs
+    );
+
 private:
     uint64_t state[STATE_SIZE];
     uint8_t buffer[RATE_BYTES];
     size_t bufferSize;
+    size_t squeezeOffset;
+    bool squeezing;
 
     void absorb();
     void keccakF();
-    uint64_t rotateLeft(uint64_t value, int shift);
     static std::string bytesToHex(const uint8_t* bytes, size_t length);
 };
 
+/**
+ * @brief Keccak-256 evaluable at compile time
+ *
+ * Identical output to Keccak256, but usable in constexpr context, so
+ * fixed protocol strings (topic selectors, EIP-712 type hashes) are
+ * hashed by the compiler and baked into rodata instead of being
+ * recomputed at every process start:
+ *
+ *   constexpr auto TYPE_HASH =
+ *       keccak256("Message(address to,bytes payload)");
+ *
+ * At runtime it runs the same scalar permutation, byte-serial on the
+ * absorb side; prefer the Keccak256 class for dynamic data.
+ */
+constexpr std::array<uint8_t, 32> keccak256(std::string_view input) {
+    uint64_t state[25] = {};
+    size_t offset = 0;
+
+    // Whole rate blocks
+    while (input.size() - offset >= Keccak256::RATE_BYTES) {
+        for (size_t i = 0; i < Keccak256::RATE_BYTES / 8; ++i) {
+            uint64_t lane = 0;
+            for (size_t j = 0; j < 8; ++j) {
+                lane |= static_cast<uint64_t>(
+                    static_cast<uint8_t>(input[offset + i * 8 + j])) << (8 * j);
+            }
+            state[i] ^= lane;
+        }
+        detail::keccakPermute(state);
+        offset += Keccak256::RATE_BYTES;
+    }
+
+    // Final padded block
+    uint8_t block[Keccak256::RATE_BYTES] = {};
+    const size_t remainder = input.size() - offset;
+    for (size_t i = 0; i < remainder; ++i) {
+        block[i] = static_cast<uint8_t>(input[offset + i]);
+    }
+    block[remainder] = 0x01;
+    block[Keccak256::RATE_BYTES - 1] |= 0x80;
+    for (size_t i = 0; i < Keccak256::RATE_BYTES / 8; ++i) {
+        uint64_t lane = 0;
+        for (size_t j = 0; j < 8; ++j) {
+            lane |= static_cast<uint64_t>(block[i * 8 + j]) << (8 * j);
+        }
+        state[i] ^= lane;
+    }
+    detail::keccakPermute(state);
+
+    std::array<uint8_t, 32> digest = {};
+    for (size_t i = 0; i < digest.size(); ++i) {
+        digest[i] = static_cast<uint8_t>(state[i / 8] >> (8 * (i % 8)));
+    }
+    return digest;
+}
+
 } // namespace crypto
 } // namespace whisper
 
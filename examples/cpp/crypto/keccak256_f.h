@@ -0,0 +1,154 @@
+#ifndef WHISPER_CRYPTO_KECCAK256_F_H
+#define WHISPER_CRYPTO_KECCAK256_F_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace whisper {
+namespace crypto {
+namespace detail {
+
+// Keccak round constants
+constexpr uint64_t KECCAK_RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/**
+ * @brief Rotate each 64-bit lane left by a compile-time-unknown shift
+ *
+ * Works for plain uint64_t as well as GCC/Clang vector types, so the
+ * same permutation body can be instantiated for 1-wide (scalar) and
+ * N-wide (SIMD lane-parallel) execution.
+ */
+template <typename W>
+constexpr W rotl64(W value, int shift) {
+    shift &= 63;
+    if (shift == 0) {
+        return value;
+    }
+    return (value << shift) | (value >> (64 - shift));
+}
+
+// Rho rotation offsets, indexed by lane position x + 5*y
+constexpr int KECCAK_RHO[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+// Pi destination index for each source lane: A'[y, 2x+3y] = A[x, y]
+constexpr int KECCAK_PI[25] = {
+     0, 10, 20,  5, 15,
+    16,  1, 11, 21,  6,
+     7, 17,  2, 12, 22,
+    23,  8, 18,  3, 13,
+    14, 24,  9, 19,  4
+};
+
+/**
+ * @brief One Keccak-f[1600] round, specialized over constexpr tables
+ *
+ * The rho offsets and pi index mapping are compile-time constants, so
+ * every rotation amount and lane index folds into the instruction
+ * stream; the b[] scratch is scalarized into registers by the compiler
+ * rather than spilled as a 200-byte state copy.
+ */
+template <typename W>
+constexpr void keccakRound(W state[25], uint64_t rc) {
+    // Theta
+    W C[5] = {};
+    for (int x = 0; x < 5; ++x) {
+        C[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+    }
+    for (int x = 0; x < 5; ++x) {
+        const W D = C[(x + 4) % 5] ^ rotl64(C[(x + 1) % 5], 1);
+        state[x] ^= D;
+        state[x + 5] ^= D;
+        state[x + 10] ^= D;
+        state[x + 15] ^= D;
+        state[x + 20] ^= D;
+    }
+
+    // Rho and Pi in one pass
+    W b[25] = {};
+    for (int i = 0; i < 25; ++i) {
+        b[KECCAK_PI[i]] = rotl64(state[i], KECCAK_RHO[i]);
+    }
+
+    // Chi
+    for (int y = 0; y < 25; y += 5) {
+        for (int x = 0; x < 5; ++x) {
+            state[y + x] = b[y + x] ^ ((~b[y + (x + 1) % 5]) & b[y + (x + 2) % 5]);
+        }
+    }
+
+    // Iota
+    state[0] ^= rc;
+}
+
+/**
+ * @brief Keccak-f[1600] permutation over a width-generic word type
+ *
+ * @tparam W uint64_t for the scalar path, or a vector-of-uint64_t type
+ *           to run several independent permutations in SIMD lanes.
+ */
+template <typename W>
+constexpr void keccakPermute(W state[25]) {
+    for (int round = 0; round < 24; ++round) {
+        keccakRound(state, KECCAK_RC[round]);
+    }
+}
+
+/**
+ * @brief Load one little-endian 64-bit lane from a possibly unaligned pointer
+ */
+inline uint64_t loadLane(const uint8_t* p) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t value;
+    __builtin_memcpy(&value, p, 8);
+    return value;
+#else
+    uint64_t value = 0;
+    for (int j = 0; j < 8; ++j) {
+        value |= static_cast<uint64_t>(p[j]) << (j * 8);
+    }
+    return value;
+#endif
+}
+
+/**
+ * @brief XOR one rate-sized block into the sponge state (little-endian lanes)
+ *
+ * Reads whole 64-bit words rather than reassembling them byte by byte,
+ * so the bulk absorb path runs at memory bandwidth.
+ */
+inline void xorBlockIntoState(uint64_t state[25], const uint8_t* block) {
+    for (size_t i = 0; i < 17; ++i) {
+        state[i] ^= loadLane(block + i * 8);
+    }
+}
+
+#ifdef WHISPER_HAVE_KECCAK_X4
+/**
+ * @brief Hash four independent messages with a 4-lane SIMD permutation
+ *
+ * Compiled in an AVX2-targeted translation unit; only call when the
+ * running CPU supports AVX2.
+ */
+void hashBatch4(const uint8_t* const inputs[4], const size_t lengths[4], uint8_t* outputs);
+#endif
+
+} // namespace detail
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_KECCAK256_F_H
@@ -0,0 +1,218 @@
+/**
+ * Streaming Merkle tree builder over Keccak-256
+ */
+
+#include "merkle_tree.h"
+#include "keccak256.h"
+#include "work_pool.h"
+
+#include <cstring>
+#include <future>
+
+namespace whisper {
+namespace crypto {
+
+MerkleTree::MerkleTree(bool recordLevels, WorkPool* pool)
+    : leafCount_(0), recordLevels_(recordLevels), pool_(pool) {
+}
+
+void MerkleTree::hashPair(const uint8_t* left, const uint8_t* right, uint8_t out[32]) {
+    Keccak256 hasher;
+    hasher.update(left, 32);
+    hasher.update(right, 32);
+    hasher.finalize(out);
+}
+
+void MerkleTree::pushNode(const Hash& node, size_t level) {
+    Hash carry = node;
+    size_t current = level;
+    for (;;) {
+        if (frontier_.size() <= current) {
+            frontier_.resize(current + 1);
+            frontierUsed_.resize(current + 1, false);
+        }
+        if (!frontierUsed_[current]) {
+            frontier_[current] = carry;
+            frontierUsed_[current] = true;
+            return;
+        }
+        // Sibling complete: combine and carry the parent up
+        Hash parent;
+        hashPair(frontier_[current].data(), carry.data(), parent.data());
+        frontierUsed_[current] = false;
+        carry = parent;
+        ++current;
+    }
+}
+
+void MerkleTree::addLeaf(const uint8_t leaf[32]) {
+    Hash node;
+    std::memcpy(node.data(), leaf, 32);
+
+    if (recordLevels_) {
+        if (levels_.empty()) {
+            levels_.emplace_back();
+        }
+        levels_[0].push_back(node);
+    }
+
+    pushNode(node, 0);
+    ++leafCount_;
+}
+
+void MerkleTree::subtreeRoot(const uint8_t* leaves, size_t count, uint8_t out[32]) {
+    // count is a power of two; reduce level by level in place
+    std::vector<Hash> nodes(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(nodes[i].data(), leaves + i * 32, 32);
+    }
+    while (nodes.size() > 1) {
+        for (size_t i = 0; i < nodes.size() / 2; ++i) {
+            hashPair(nodes[2 * i].data(), nodes[2 * i + 1].data(), nodes[i].data());
+        }
+        nodes.resize(nodes.size() / 2);
+    }
+    std::memcpy(out, nodes[0].data(), 32);
+}
+
+void MerkleTree::addLeaves(const uint8_t* leaves, size_t count) {
+    if (recordLevels_ || pool_ == nullptr) {
+        for (size_t i = 0; i < count; ++i) {
+            addLeaf(leaves + i * 32);
+        }
+        return;
+    }
+
+    // Split into perfect subtrees aligned to the current position,
+    // hash their roots in parallel, then merge roots into the frontier
+    struct Chunk {
+        size_t level;
+        std::future<void> done;
+        Hash rootHash;
+    };
+    std::vector<Chunk> chunks;
+    // Block sizes form an ascending then descending power-of-two run,
+    // so the chunk count is bounded; reserve so queued jobs' rootHash
+    // pointers stay valid
+    chunks.reserve(128);
+
+    size_t offset = 0;
+    size_t position = leafCount_;
+    while (offset < count) {
+        // Largest power of two allowed by alignment and remaining count
+        size_t block = position == 0
+            ? (size_t(1) << (8 * sizeof(size_t) - 1))
+            : (position & (~position + 1));
+        size_t remaining = count - offset;
+        while (block > remaining) {
+            block >>= 1;
+        }
+
+        size_t level = 0;
+        for (size_t b = block; b > 1; b >>= 1) {
+            ++level;
+        }
+
+        chunks.emplace_back();
+        Chunk& chunk = chunks.back();
+        chunk.level = level;
+        const uint8_t* base = leaves + offset * 32;
+        Hash* target = &chunk.rootHash;
+        chunk.done = pool_->submitJob([base, block, target](SECP256k1Wrapper&) {
+            subtreeRoot(base, block, target->data());
+        });
+
+        offset += block;
+        position += block;
+    }
+
+    for (Chunk& chunk : chunks) {
+        chunk.done.get();
+        pushNode(chunk.rootHash, chunk.level);
+    }
+    leafCount_ += count;
+}
+
+void MerkleTree::root(uint8_t out[32]) const {
+    if (leafCount_ == 0) {
+        // Root of an empty tree: hash of nothing
+        Keccak256 hasher;
+        hasher.finalize(out);
+        return;
+    }
+
+    // Climb the frontier, promoting the running node unchanged where a
+    // level has no pending sibling
+    bool haveNode = false;
+    Hash current;
+    for (size_t level = 0; level < frontier_.size(); ++level) {
+        if (!frontierUsed_[level]) {
+            continue;
+        }
+        if (!haveNode) {
+            current = frontier_[level];
+            haveNode = true;
+        } else {
+            Hash parent;
+            hashPair(frontier_[level].data(), current.data(), parent.data());
+            current = parent;
+        }
+    }
+    std::memcpy(out, current.data(), 32);
+}
+
+bool MerkleTree::proof(size_t leafIndex, std::vector<ProofStep>& out) const {
+    if (!recordLevels_ || leafIndex >= leafCount_) {
+        return false;
+    }
+
+    out.clear();
+
+    // Materialize upper levels lazily from the recorded leaf level
+    std::vector<Hash> level = levels_[0];
+    size_t index = leafIndex;
+    while (level.size() > 1) {
+        if (index % 2 == 0) {
+            if (index + 1 < level.size()) {
+                out.push_back(ProofStep{level[index + 1], false});
+            }
+            // else: promoted unchanged, no sibling step
+        } else {
+            out.push_back(ProofStep{level[index - 1], true});
+        }
+
+        std::vector<Hash> next((level.size() + 1) / 2);
+        for (size_t i = 0; i < next.size(); ++i) {
+            if (2 * i + 1 < level.size()) {
+                hashPair(level[2 * i].data(), level[2 * i + 1].data(), next[i].data());
+            } else {
+                next[i] = level[2 * i];
+            }
+        }
+        level.swap(next);
+        index /= 2;
+    }
+    return true;
+}
+
+bool MerkleTree::verifyProof(
+    const uint8_t leaf[32],
+    const std::vector<ProofStep>& proof,
+    const uint8_t expectedRoot[32]
+) {
+    Hash current;
+    std::memcpy(current.data(), leaf, 32);
+    for (const ProofStep& step : proof) {
+        Hash parent;
+        if (step.siblingOnLeft) {
+            hashPair(step.sibling.data(), current.data(), parent.data());
+        } else {
+            hashPair(current.data(), step.sibling.data(), parent.data());
+        }
+        current = parent;
+    }
+    return std::memcmp(current.data(), expectedRoot, 32) == 0;
+}
+
+} // namespace crypto
+} // namespace whisper
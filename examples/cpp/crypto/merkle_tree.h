@@ -0,0 +1,101 @@
+#ifndef WHISPER_CRYPTO_MERKLE_TREE_H
+#define WHISPER_CRYPTO_MERKLE_TREE_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace whisper {
+namespace crypto {
+
+class WorkPool;
+
+/**
+ * @brief Streaming Merkle tree builder over Keccak-256
+ *
+ * Consumes 32-byte leaves incrementally and keeps only the O(log n)
+ * frontier (one pending left node per level), so a 1M-leaf checkpoint
+ * never materializes intermediate levels. A node without a right
+ * sibling is promoted unchanged; interior nodes are
+ * Keccak-256(left || right).
+ *
+ * Construct with recordLevels = true to additionally keep every level
+ * (O(n) memory) so inclusion proofs can be emitted without rebuilding
+ * the tree. Bulk ingestion can parallelize perfect-subtree hashing
+ * across a WorkPool.
+ */
+class MerkleTree {
+public:
+    using Hash = std::array<uint8_t, 32>;
+
+    /**
+     * @brief One step of an inclusion proof
+     */
+    struct ProofStep {
+        Hash sibling;
+        bool siblingOnLeft;
+    };
+
+    /**
+     * @brief Create a builder
+     * @param recordLevels Keep all levels so proofs can be emitted
+     * @param pool Optional pool for parallel bulk ingestion
+     */
+    explicit MerkleTree(bool recordLevels = false, WorkPool* pool = nullptr);
+
+    /**
+     * @brief Append one 32-byte leaf
+     */
+    void addLeaf(const uint8_t leaf[32]);
+
+    /**
+     * @brief Append many contiguous 32-byte leaves
+     *
+     * In streaming mode with a pool attached, perfect subtrees are
+     * hashed in parallel and their roots merged into the frontier.
+     */
+    void addLeaves(const uint8_t* leaves, size_t count);
+
+    /**
+     * @brief Compute the root over the leaves added so far
+     *
+     * Does not consume the builder; more leaves may be added after.
+     */
+    void root(uint8_t out[32]) const;
+
+    /**
+     * @brief Emit the inclusion proof for a leaf
+     * @return false unless built with recordLevels and index in range
+     */
+    bool proof(size_t leafIndex, std::vector<ProofStep>& out) const;
+
+    /**
+     * @brief Check an inclusion proof against a root
+     */
+    static bool verifyProof(
+        const uint8_t leaf[32],
+        const std::vector<ProofStep>& proof,
+        const uint8_t expectedRoot[32]
+    );
+
+    size_t leafCount() const { return leafCount_; }
+
+private:
+    static void hashPair(const uint8_t* left, const uint8_t* right, uint8_t out[32]);
+    static void subtreeRoot(const uint8_t* leaves, size_t count, uint8_t out[32]);
+    void pushNode(const Hash& node, size_t level);
+
+    // frontier_[i] is the pending left node at level i, if any
+    std::vector<Hash> frontier_;
+    std::vector<bool> frontierUsed_;
+    std::vector<std::vector<Hash>> levels_;
+    size_t leafCount_;
+    bool recordLevels_;
+    WorkPool* pool_;
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_MERKLE_TREE_H
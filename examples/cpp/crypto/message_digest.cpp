@@ -0,0 +1,166 @@
+/**
+ * EIP-191 / EIP-712 digest engine
+ *
+ * Assembles Ethereum signing digests without heap strings: fixed
+ * prefixes and domain separators live in cached Keccak midstates that
+ * are fork()ed per message, and struct fields are encoded straight
+ * into the sponge.
+ */
+
+#include "message_digest.h"
+
+#include <cstring>
+
+namespace whisper {
+namespace crypto {
+
+namespace {
+
+const char PERSONAL_PREFIX[] = "\x19""Ethereum Signed Message:\n";
+
+const Keccak256& personalPrefixMidstate() {
+    static const Keccak256 midstate = [] {
+        Keccak256 hasher;
+        hasher.update(
+            reinterpret_cast<const uint8_t*>(PERSONAL_PREFIX),
+            sizeof(PERSONAL_PREFIX) - 1
+        );
+        return hasher;
+    }();
+    return midstate;
+}
+
+// Decimal digits of value, written backwards from the end of a stack
+// buffer; returns the first digit's position
+size_t formatDecimal(uint64_t value, char (&buf)[20]) {
+    size_t pos = sizeof(buf);
+    do {
+        buf[--pos] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return pos;
+}
+
+// enc(uint64) = 32-byte big-endian word
+void writeWord(uint8_t out[32], uint64_t value) {
+    std::memset(out, 0, 24);
+    for (int i = 0; i < 8; ++i) {
+        out[24 + i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+} // namespace
+
+void personalDigest(const uint8_t* message, size_t length, uint8_t digest[32]) {
+    Keccak256 hasher = personalPrefixMidstate().fork();
+    char digits[20];
+    size_t pos = formatDecimal(length, digits);
+    hasher.update(
+        reinterpret_cast<const uint8_t*>(digits + pos),
+        sizeof(digits) - pos
+    );
+    hasher.update(message, length);
+    hasher.finalize(digest);
+}
+
+void typeHash(const char* signature, uint8_t hash[32]) {
+    Keccak256 hasher;
+    hasher.update(
+        reinterpret_cast<const uint8_t*>(signature),
+        std::strlen(signature)
+    );
+    hasher.finalize(hash);
+}
+
+StructHasher::StructHasher(const uint8_t typeHash[32]) {
+    std::memcpy(typeHash_, typeHash, 32);
+    hasher_.update(typeHash_, 32);
+}
+
+void StructHasher::reset() {
+    hasher_.reset();
+    hasher_.update(typeHash_, 32);
+}
+
+void StructHasher::addUint256(const uint8_t value[32]) {
+    hasher_.update(value, 32);
+}
+
+void StructHasher::addUint64(uint64_t value) {
+    uint8_t word[32];
+    writeWord(word, value);
+    hasher_.update(word, 32);
+}
+
+void StructHasher::addBool(bool value) {
+    addUint64(value ? 1 : 0);
+}
+
+void StructHasher::addAddress(const uint8_t address[20]) {
+    uint8_t word[32];
+    std::memset(word, 0, 12);
+    std::memcpy(word + 12, address, 20);
+    hasher_.update(word, 32);
+}
+
+void StructHasher::addBytes32(const uint8_t value[32]) {
+    hasher_.update(value, 32);
+}
+
+void StructHasher::addString(const char* value, size_t length) {
+    addBytes(reinterpret_cast<const uint8_t*>(value), length);
+}
+
+void StructHasher::addBytes(const uint8_t* value, size_t length) {
+    Keccak256 inner;
+    uint8_t digest[32];
+    inner.update(value, length);
+    inner.finalize(digest);
+    hasher_.update(digest, 32);
+}
+
+void StructHasher::addStruct(const uint8_t structHash[32]) {
+    hasher_.update(structHash, 32);
+}
+
+void StructHasher::finalize(uint8_t structHash[32]) {
+    hasher_.finalize(structHash);
+}
+
+TypedDataDomain::TypedDataDomain(const uint8_t domainSeparator[32]) {
+    std::memcpy(separator_, domainSeparator, 32);
+    const uint8_t prefix[2] = {0x19, 0x01};
+    midstate_.update(prefix, 2);
+    midstate_.update(separator_, 32);
+}
+
+void TypedDataDomain::computeSeparator(
+    const char* name,
+    const char* version,
+    uint64_t chainId,
+    const uint8_t verifyingContract[20],
+    uint8_t separator[32]
+) {
+    static const char DOMAIN_TYPE[] =
+        "EIP712Domain(string name,string version,"
+        "uint256 chainId,address verifyingContract)";
+
+    uint8_t domainTypeHash[32];
+    typeHash(DOMAIN_TYPE, domainTypeHash);
+
+    StructHasher hasher(domainTypeHash);
+    hasher.addString(name, std::strlen(name));
+    hasher.addString(version, std::strlen(version));
+    hasher.addUint64(chainId);
+    hasher.addAddress(verifyingContract);
+    hasher.finalize(separator);
+}
+
+void TypedDataDomain::digest(const uint8_t structHash[32], uint8_t out[32]) const {
+    Keccak256 hasher = midstate_.fork();
+    hasher.update(structHash, 32);
+    hasher.finalize(out);
+}
+
+} // namespace crypto
+} // namespace whisper
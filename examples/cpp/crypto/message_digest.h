@@ -0,0 +1,109 @@
+#ifndef WHISPER_CRYPTO_MESSAGE_DIGEST_H
+#define WHISPER_CRYPTO_MESSAGE_DIGEST_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include "keccak256.h"
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief EIP-191 personal_sign digest
+ *
+ * Keccak-256 over "\x19Ethereum Signed Message:\n" + decimal length +
+ * message. The fixed prefix is absorbed once into a process-wide
+ * midstate and fork()ed per call; the length digits are formatted on
+ * the stack, so no heap allocation occurs.
+ */
+void personalDigest(const uint8_t* message, size_t length, uint8_t digest[32]);
+
+/**
+ * @brief Keccak-256 of a type signature string, e.g.
+ *        "Mail(address from,address to,string contents)"
+ */
+void typeHash(const char* signature, uint8_t hash[32]);
+
+/**
+ * @brief Incremental EIP-712 struct hasher
+ *
+ * hashStruct(s) = keccak256(typeHash || enc(field1) || ... ). Fields
+ * are encoded straight into the sponge as 32-byte words; dynamic types
+ * (strings, bytes) are hashed in place with a stack-local hasher
+ * first, per the spec. Reuse across messages via reset().
+ */
+class StructHasher {
+public:
+    explicit StructHasher(const uint8_t typeHash[32]);
+
+    /// Restart with the same type hash
+    void reset();
+
+    void addUint256(const uint8_t value[32]);
+    void addUint64(uint64_t value);
+    void addBool(bool value);
+    void addAddress(const uint8_t address[20]);
+    void addBytes32(const uint8_t value[32]);
+
+    /// Dynamic string field: encoded as keccak256(value)
+    void addString(const char* value, size_t length);
+
+    /// Dynamic bytes field: encoded as keccak256(value)
+    void addBytes(const uint8_t* value, size_t length);
+
+    /// Nested struct field: encoded as its hashStruct
+    void addStruct(const uint8_t structHash[32]);
+
+    void finalize(uint8_t structHash[32]);
+
+private:
+    uint8_t typeHash_[32];
+    Keccak256 hasher_;
+};
+
+/**
+ * @brief EIP-712 signing domain with a cached digest midstate
+ *
+ * The final digest is keccak256("\x19\x01" || domainSeparator ||
+ * hashStruct(message)). The separator never changes for a domain, so
+ * the constructor absorbs the prefix and separator once; digest()
+ * forks that midstate and pays only for the 32-byte struct hash.
+ */
+class TypedDataDomain {
+public:
+    /**
+     * @brief Build from a precomputed 32-byte domain separator
+     */
+    explicit TypedDataDomain(const uint8_t domainSeparator[32]);
+
+    /**
+     * @brief Build the standard EIP712Domain separator
+     *
+     * Covers the common (name, version, chainId, verifyingContract)
+     * domain shape.
+     */
+    static void computeSeparator(
+        const char* name,
+        const char* version,
+        uint64_t chainId,
+        const uint8_t verifyingContract[20],
+        uint8_t separator[32]
+    );
+
+    /**
+     * @brief Final signing digest for a struct hash
+     */
+    void digest(const uint8_t structHash[32], uint8_t out[32]) const;
+
+    const uint8_t* separator() const { return separator_; }
+
+private:
+    uint8_t separator_[32];
+    Keccak256 midstate_;
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_MESSAGE_DIGEST_H
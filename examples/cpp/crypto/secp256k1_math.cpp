@@ -0,0 +1,891 @@
+/**
+ * Portable secp256k1 arithmetic backend
+ *
+ * Constant-fold modular reduction over 64-bit limbs, Jacobian group
+ * law, windowed scalar multiplication and ECDSA sign/verify/recover.
+ * Used when the library is built without libsecp256k1.
+ */
+
+#include "secp256k1_math.h"
+#include "keccak256.h"
+
+#include <cstring>
+
+namespace whisper {
+namespace crypto {
+namespace ec {
+
+__extension__ typedef unsigned __int128 uint128_t;
+
+// p = 2^256 - 2^32 - 977
+const Mod FIELD_P = {
+    {{0xFFFFFFFEFFFFFC2FULL, 0xFFFFFFFFFFFFFFFFULL,
+      0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL}},
+    {0x00000001000003D1ULL, 0, 0},
+    1
+};
+
+// n = order of G
+const Mod ORDER_N = {
+    {{0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL,
+      0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL}},
+    {0x402DA1732FC9BEBFULL, 0x4551231950B75FC4ULL, 1},
+    3
+};
+
+const Point G = {
+    {{0x59F2815B16F81798ULL, 0x029BFCDB2DCE28D9ULL,
+      0x55A06295CE870B07ULL, 0x79BE667EF9DCBBACULL}},
+    {{0x9C47D08FFB10D4B8ULL, 0xFD17B448A6855419ULL,
+      0x5DA4FBFC0E1108A8ULL, 0x483ADA7726A3C465ULL}},
+    false
+};
+
+// --- 256-bit integer helpers -------------------------------------------------
+
+bool u256IsZero(const U256& a) {
+    return (a.w[0] | a.w[1] | a.w[2] | a.w[3]) == 0;
+}
+
+int u256Cmp(const U256& a, const U256& b) {
+    for (int i = 3; i >= 0; --i) {
+        if (a.w[i] < b.w[i]) return -1;
+        if (a.w[i] > b.w[i]) return 1;
+    }
+    return 0;
+}
+
+static uint64_t u256Add(U256& r, const U256& a, const U256& b) {
+    uint128_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        carry += static_cast<uint128_t>(a.w[i]) + b.w[i];
+        r.w[i] = static_cast<uint64_t>(carry);
+        carry >>= 64;
+    }
+    return static_cast<uint64_t>(carry);
+}
+
+static uint64_t u256Sub(U256& r, const U256& a, const U256& b) {
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t bi = b.w[i];
+        uint64_t t = a.w[i] - bi;
+        uint64_t borrowOut = (a.w[i] < bi) ? 1 : 0;
+        uint64_t t2 = t - borrow;
+        borrowOut |= (t < borrow) ? 1 : 0;
+        r.w[i] = t2;
+        borrow = borrowOut;
+    }
+    return borrow;
+}
+
+void u256FromBytes(U256& r, const uint8_t bytes[32]) {
+    for (int i = 0; i < 4; ++i) {
+        uint64_t v = 0;
+        for (int j = 0; j < 8; ++j) {
+            v = (v << 8) | bytes[(3 - i) * 8 + j];
+        }
+        r.w[i] = v;
+    }
+}
+
+void u256ToBytes(const U256& a, uint8_t bytes[32]) {
+    for (int i = 0; i < 4; ++i) {
+        uint64_t v = a.w[3 - i];
+        for (int j = 7; j >= 0; --j) {
+            bytes[i * 8 + j] = static_cast<uint8_t>(v);
+            v >>= 8;
+        }
+    }
+}
+
+static bool u256Bit(const U256& a, int bit) {
+    return (a.w[bit >> 6] >> (bit & 63)) & 1;
+}
+
+// --- modular reduction -------------------------------------------------------
+
+// Schoolbook 4x4 -> 8 limb multiply
+static void mulWide(uint64_t out[8], const U256& a, const U256& b) {
+    std::memset(out, 0, 8 * sizeof(uint64_t));
+    for (int i = 0; i < 4; ++i) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; ++j) {
+            uint128_t acc = static_cast<uint128_t>(a.w[i]) * b.w[j];
+            acc += out[i + j];
+            acc += carry;
+            out[i + j] = static_cast<uint64_t>(acc);
+            carry = static_cast<uint64_t>(acc >> 64);
+        }
+        out[i + 4] = carry;
+    }
+}
+
+// Reduce a wide value by repeatedly folding the limbs above 2^256:
+// lo + hi*2^256 == lo + hi*(2^256 - m) (mod m)
+static void reduceWide(U256& r, const uint64_t in[8], const Mod& mod) {
+    uint64_t buf[12];
+    std::memcpy(buf, in, 8 * sizeof(uint64_t));
+    std::memset(buf + 8, 0, 4 * sizeof(uint64_t));
+    int len = 8;
+    while (len > 4 && buf[len - 1] == 0) --len;
+
+    while (len > 4) {
+        const int hiLen = len - 4;
+        uint64_t hi[8];
+        std::memcpy(hi, buf + 4, hiLen * sizeof(uint64_t));
+        std::memset(buf + 4, 0, 8 * sizeof(uint64_t));
+
+        // buf(0..3) += hi * fold
+        uint64_t prod[12];
+        std::memset(prod, 0, sizeof(prod));
+        for (int i = 0; i < hiLen; ++i) {
+            uint64_t carry = 0;
+            for (int j = 0; j < mod.foldLimbs; ++j) {
+                uint128_t acc = static_cast<uint128_t>(hi[i]) * mod.fold[j];
+                acc += prod[i + j];
+                acc += carry;
+                prod[i + j] = static_cast<uint64_t>(acc);
+                carry = static_cast<uint64_t>(acc >> 64);
+            }
+            prod[i + mod.foldLimbs] += carry;
+        }
+
+        uint128_t carry = 0;
+        int newLen = hiLen + mod.foldLimbs + 1;
+        if (newLen < 5) newLen = 5;
+        for (int i = 0; i < newLen; ++i) {
+            carry += static_cast<uint128_t>(buf[i]) + prod[i];
+            buf[i] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        len = newLen;
+        while (len > 4 && buf[len - 1] == 0) --len;
+    }
+
+    std::memcpy(r.w, buf, sizeof(r.w));
+    while (u256Cmp(r, mod.m) >= 0) {
+        u256Sub(r, r, mod.m);
+    }
+}
+
+void modReduce(U256& r, const Mod& mod) {
+    while (u256Cmp(r, mod.m) >= 0) {
+        u256Sub(r, r, mod.m);
+    }
+}
+
+void modAdd(U256& r, const U256& a, const U256& b, const Mod& mod) {
+    uint64_t carry = u256Add(r, a, b);
+    if (carry || u256Cmp(r, mod.m) >= 0) {
+        u256Sub(r, r, mod.m);
+    }
+}
+
+void modSub(U256& r, const U256& a, const U256& b, const Mod& mod) {
+    if (u256Sub(r, a, b)) {
+        u256Add(r, r, mod.m);
+    }
+}
+
+void modMul(U256& r, const U256& a, const U256& b, const Mod& mod) {
+    uint64_t wide[8];
+    mulWide(wide, a, b);
+    reduceWide(r, wide, mod);
+}
+
+void modSqr(U256& r, const U256& a, const Mod& mod) {
+    modMul(r, a, a, mod);
+}
+
+void modPow(U256& r, const U256& base, const U256& exp, const Mod& mod) {
+    U256 result = {{1, 0, 0, 0}};
+    for (int bit = 255; bit >= 0; --bit) {
+        modSqr(result, result, mod);
+        if (u256Bit(exp, bit)) {
+            modMul(result, result, base, mod);
+        }
+    }
+    r = result;
+}
+
+void modInv(U256& r, const U256& a, const Mod& mod) {
+    // Fermat: a^(m-2) mod m
+    U256 exp = mod.m;
+    U256 two = {{2, 0, 0, 0}};
+    u256Sub(exp, exp, two);
+    modPow(r, a, exp, mod);
+}
+
+// --- group operations --------------------------------------------------------
+
+void jacobianFromAffine(Jacobian& r, const Point& p) {
+    r.x = p.x;
+    r.y = p.y;
+    r.z = U256{{1, 0, 0, 0}};
+    r.infinity = p.infinity;
+}
+
+void jacobianDouble(Jacobian& r, const Jacobian& p) {
+    if (p.infinity || u256IsZero(p.y)) {
+        r.infinity = true;
+        return;
+    }
+
+    U256 ysq, s, m, t;
+    modSqr(ysq, p.y, FIELD_P);              // Y^2
+    modMul(s, p.x, ysq, FIELD_P);
+    modAdd(s, s, s, FIELD_P);
+    modAdd(s, s, s, FIELD_P);               // S = 4*X*Y^2
+    modSqr(m, p.x, FIELD_P);
+    modAdd(t, m, m, FIELD_P);
+    modAdd(m, t, m, FIELD_P);               // M = 3*X^2 (a = 0)
+
+    Jacobian out;
+    out.infinity = false;
+    modSqr(out.x, m, FIELD_P);
+    modAdd(t, s, s, FIELD_P);
+    modSub(out.x, out.x, t, FIELD_P);       // X' = M^2 - 2*S
+
+    modSqr(t, ysq, FIELD_P);
+    modAdd(t, t, t, FIELD_P);
+    modAdd(t, t, t, FIELD_P);
+    modAdd(t, t, t, FIELD_P);               // 8*Y^4
+    modSub(out.y, s, out.x, FIELD_P);
+    modMul(out.y, out.y, m, FIELD_P);
+    modSub(out.y, out.y, t, FIELD_P);       // Y' = M*(S - X') - 8*Y^4
+
+    modMul(out.z, p.y, p.z, FIELD_P);
+    modAdd(out.z, out.z, out.z, FIELD_P);   // Z' = 2*Y*Z
+
+    r = out;
+}
+
+void jacobianAdd(Jacobian& r, const Jacobian& p, const Jacobian& q) {
+    if (p.infinity) { r = q; return; }
+    if (q.infinity) { r = p; return; }
+
+    U256 z1sq, z2sq, u1, u2, s1, s2, t;
+    modSqr(z1sq, p.z, FIELD_P);
+    modSqr(z2sq, q.z, FIELD_P);
+    modMul(u1, p.x, z2sq, FIELD_P);
+    modMul(u2, q.x, z1sq, FIELD_P);
+    modMul(t, z2sq, q.z, FIELD_P);
+    modMul(s1, p.y, t, FIELD_P);
+    modMul(t, z1sq, p.z, FIELD_P);
+    modMul(s2, q.y, t, FIELD_P);
+
+    if (u256Cmp(u1, u2) == 0) {
+        if (u256Cmp(s1, s2) != 0) {
+            r.infinity = true;
+            return;
+        }
+        jacobianDouble(r, p);
+        return;
+    }
+
+    U256 h, rr, hsq, hcu, u1hsq;
+    modSub(h, u2, u1, FIELD_P);
+    modSub(rr, s2, s1, FIELD_P);
+    modSqr(hsq, h, FIELD_P);
+    modMul(hcu, hsq, h, FIELD_P);
+    modMul(u1hsq, u1, hsq, FIELD_P);
+
+    Jacobian out;
+    out.infinity = false;
+    modSqr(out.x, rr, FIELD_P);
+    modSub(out.x, out.x, hcu, FIELD_P);
+    modAdd(t, u1hsq, u1hsq, FIELD_P);
+    modSub(out.x, out.x, t, FIELD_P);       // X3 = R^2 - H^3 - 2*U1*H^2
+
+    modSub(out.y, u1hsq, out.x, FIELD_P);
+    modMul(out.y, out.y, rr, FIELD_P);
+    modMul(t, s1, hcu, FIELD_P);
+    modSub(out.y, out.y, t, FIELD_P);       // Y3 = R*(U1*H^2 - X3) - S1*H^3
+
+    modMul(out.z, p.z, q.z, FIELD_P);
+    modMul(out.z, out.z, h, FIELD_P);       // Z3 = H*Z1*Z2
+
+    r = out;
+}
+
+void jacobianAddAffine(Jacobian& r, const Jacobian& p, const Point& q) {
+    Jacobian jq;
+    jacobianFromAffine(jq, q);
+    jacobianAdd(r, p, jq);
+}
+
+void jacobianToAffine(Point& r, const Jacobian& p) {
+    if (p.infinity) {
+        r.infinity = true;
+        return;
+    }
+    U256 zinv, zinv2;
+    modInv(zinv, p.z, FIELD_P);
+    modSqr(zinv2, zinv, FIELD_P);
+    modMul(r.x, p.x, zinv2, FIELD_P);
+    modMul(zinv2, zinv2, zinv, FIELD_P);
+    modMul(r.y, p.y, zinv2, FIELD_P);
+    r.infinity = false;
+}
+
+void scalarMult(Jacobian& r, const Point& base, const U256& k) {
+    // 4-bit fixed window over on-the-fly multiples of base
+    Jacobian table[16];
+    table[0].infinity = true;
+    jacobianFromAffine(table[1], base);
+    for (int i = 2; i < 16; ++i) {
+        if (i % 2 == 0) {
+            jacobianDouble(table[i], table[i / 2]);
+        } else {
+            jacobianAdd(table[i], table[i - 1], table[1]);
+        }
+    }
+
+    Jacobian acc;
+    acc.infinity = true;
+    for (int window = 63; window >= 0; --window) {
+        if (!acc.infinity) {
+            jacobianDouble(acc, acc);
+            jacobianDouble(acc, acc);
+            jacobianDouble(acc, acc);
+            jacobianDouble(acc, acc);
+        }
+        const unsigned digit =
+            static_cast<unsigned>(k.w[window >> 4] >> ((window & 15) * 4)) & 0xF;
+        if (digit != 0) {
+            jacobianAdd(acc, acc, table[digit]);
+        }
+    }
+    r = acc;
+}
+
+void scalarMultG(Jacobian& r, const U256& k) {
+    scalarMult(r, G, k);
+}
+
+namespace {
+
+// Fixed-base comb: COMB[w][d - 1] = d * 16^w * G in affine form, so
+// k*G is one mixed addition per nonzero 4-bit digit of k
+struct CombTable {
+    Point entry[64][15];
+};
+
+const CombTable& combTable() {
+    static const CombTable table = [] {
+        CombTable t;
+        Jacobian base;
+        jacobianFromAffine(base, G);
+        for (int w = 0; w < 64; ++w) {
+            Jacobian multiples[16];
+            multiples[1] = base;
+            for (int d = 2; d < 16; ++d) {
+                jacobianAdd(multiples[d], multiples[d - 1], base);
+            }
+            for (int d = 1; d < 16; ++d) {
+                jacobianToAffine(t.entry[w][d - 1], multiples[d]);
+            }
+            jacobianDouble(base, base);
+            jacobianDouble(base, base);
+            jacobianDouble(base, base);
+            jacobianDouble(base, base);
+        }
+        return t;
+    }();
+    return table;
+}
+
+} // namespace
+
+void ensureGeneratorPrecomp() {
+    combTable();
+}
+
+void scalarMultGFixedBase(Jacobian& r, const U256& k) {
+    const CombTable& table = combTable();
+    Jacobian acc;
+    acc.infinity = true;
+    for (int w = 0; w < 64; ++w) {
+        const unsigned digit =
+            static_cast<unsigned>(k.w[w >> 4] >> ((w & 15) * 4)) & 0xF;
+        if (digit != 0) {
+            jacobianAddAffine(acc, acc, table.entry[w][digit - 1]);
+        }
+    }
+    r = acc;
+}
+
+namespace {
+
+struct WindowTable {
+    Jacobian entry[16];
+};
+
+void buildWindowTable(WindowTable& t, const Point& base) {
+    t.entry[0].infinity = true;
+    jacobianFromAffine(t.entry[1], base);
+    for (int i = 2; i < 16; ++i) {
+        if (i % 2 == 0) {
+            jacobianDouble(t.entry[i], t.entry[i / 2]);
+        } else {
+            jacobianAdd(t.entry[i], t.entry[i - 1], t.entry[1]);
+        }
+    }
+}
+
+const WindowTable& generatorTable() {
+    static const WindowTable table = [] {
+        WindowTable t;
+        buildWindowTable(t, G);
+        return t;
+    }();
+    return table;
+}
+
+unsigned windowDigit(const U256& k, int window) {
+    return static_cast<unsigned>(k.w[window >> 4] >> ((window & 15) * 4)) & 0xF;
+}
+
+} // namespace
+
+void doubleScalarMultG(Jacobian& r, const U256& u1, const Point& q, const U256& u2) {
+    const WindowTable& tg = generatorTable();
+    WindowTable tq;
+    buildWindowTable(tq, q);
+
+    Jacobian acc;
+    acc.infinity = true;
+    for (int window = 63; window >= 0; --window) {
+        if (!acc.infinity) {
+            jacobianDouble(acc, acc);
+            jacobianDouble(acc, acc);
+            jacobianDouble(acc, acc);
+            jacobianDouble(acc, acc);
+        }
+        const unsigned d1 = windowDigit(u1, window);
+        if (d1 != 0) {
+            jacobianAdd(acc, acc, tg.entry[d1]);
+        }
+        const unsigned d2 = windowDigit(u2, window);
+        if (d2 != 0) {
+            jacobianAdd(acc, acc, tq.entry[d2]);
+        }
+    }
+    r = acc;
+}
+
+bool isOnCurve(const Point& p) {
+    if (p.infinity) {
+        return false;
+    }
+    if (u256Cmp(p.x, FIELD_P.m) >= 0 || u256Cmp(p.y, FIELD_P.m) >= 0) {
+        return false;
+    }
+    U256 lhs, rhs;
+    modSqr(lhs, p.y, FIELD_P);
+    modSqr(rhs, p.x, FIELD_P);
+    modMul(rhs, rhs, p.x, FIELD_P);
+    const U256 seven = {{7, 0, 0, 0}};
+    modAdd(rhs, rhs, seven, FIELD_P);
+    return u256Cmp(lhs, rhs) == 0;
+}
+
+// sqrt via a^((p+1)/4), valid since p == 3 (mod 4); false when a is a
+// non-residue
+static bool fieldSqrt(U256& r, const U256& a) {
+    U256 exp = FIELD_P.m;
+    const U256 one = {{1, 0, 0, 0}};
+    u256Add(exp, exp, one);
+    for (int i = 0; i < 4; ++i) {
+        uint64_t next = (i < 3) ? exp.w[i + 1] : 0;
+        exp.w[i] = (exp.w[i] >> 2) | (next << 62);
+    }
+    modPow(r, a, exp, FIELD_P);
+    U256 check;
+    modSqr(check, r, FIELD_P);
+    return u256Cmp(check, a) == 0;
+}
+
+void compressPublicKey(const uint8_t publicKey[64], uint8_t compressed[33]) {
+    compressed[0] = (publicKey[63] & 1) ? 0x03 : 0x02;
+    std::memcpy(compressed + 1, publicKey, 32);
+}
+
+bool decompressPublicKey(const uint8_t compressed[33], uint8_t publicKey[64]) {
+    if (compressed[0] != 0x02 && compressed[0] != 0x03) {
+        return false;
+    }
+    U256 x;
+    u256FromBytes(x, compressed + 1);
+    if (u256Cmp(x, FIELD_P.m) >= 0) {
+        return false;
+    }
+
+    U256 alpha;
+    modSqr(alpha, x, FIELD_P);
+    modMul(alpha, alpha, x, FIELD_P);
+    const U256 seven = {{7, 0, 0, 0}};
+    modAdd(alpha, alpha, seven, FIELD_P);
+
+    U256 y;
+    if (!fieldSqrt(y, alpha)) {
+        return false;
+    }
+    if ((u256Bit(y, 0) ? 1 : 0) != (compressed[0] & 1)) {
+        modSub(y, FIELD_P.m, y, FIELD_P);
+    }
+
+    u256ToBytes(x, publicKey);
+    u256ToBytes(y, publicKey + 32);
+    return true;
+}
+
+// --- ECDSA -------------------------------------------------------------------
+
+static bool loadScalar(U256& r, const uint8_t bytes[32]) {
+    u256FromBytes(r, bytes);
+    return !u256IsZero(r) && u256Cmp(r, ORDER_N.m) < 0;
+}
+
+static bool loadPublicKey(Point& p, const uint8_t publicKey[64]) {
+    u256FromBytes(p.x, publicKey);
+    u256FromBytes(p.y, publicKey + 32);
+    p.infinity = false;
+    return isOnCurve(p);
+}
+
+// HMAC over Keccak-256 (136-byte block). The two key pads are kept as
+// forkable midstates, so after setKey each MAC pays only for its
+// message blocks, not for re-absorbing the pads.
+class HmacKeccak {
+public:
+    void setKey(const uint8_t key[32]) {
+        uint8_t pad[Keccak256::RATE_BYTES];
+        inner_.reset();
+        outer_.reset();
+        for (size_t i = 0; i < sizeof(pad); ++i) {
+            pad[i] = static_cast<uint8_t>((i < 32 ? key[i] : 0) ^ 0x36);
+        }
+        inner_.update(pad, sizeof(pad));
+        for (size_t i = 0; i < sizeof(pad); ++i) {
+            pad[i] ^= 0x36 ^ 0x5C;
+        }
+        outer_.update(pad, sizeof(pad));
+    }
+
+    // out = HMAC(key, d1 || d2); either part may be empty. out may
+    // alias d1/d2: it is written only after the inputs are consumed.
+    void mac(
+        const uint8_t* d1, size_t l1,
+        const uint8_t* d2, size_t l2,
+        uint8_t out[32]
+    ) {
+        Keccak256 hasher = inner_.fork();
+        if (l1 > 0) {
+            hasher.update(d1, l1);
+        }
+        if (l2 > 0) {
+            hasher.update(d2, l2);
+        }
+        uint8_t digest[32];
+        hasher.finalize(digest);
+
+        Keccak256 outerHasher = outer_.fork();
+        outerHasher.update(digest, 32);
+        outerHasher.finalize(out);
+    }
+
+private:
+    Keccak256 inner_;
+    Keccak256 outer_;
+};
+
+// RFC 6979 deterministic nonce generator, with Keccak-256 standing in
+// for the HMAC hash (same HMAC-DRBG structure and retry rules; not
+// compatible with the SHA-2 test vectors). Deterministic nonces let
+// replicas cross-check signatures byte for byte. The generator is
+// reusable: seed() fully reinitializes it for the next message.
+class NonceGenerator {
+public:
+    void seed(const uint8_t privateKey[32], const U256& z) {
+        // suffix = sep || int2octets(x) || bits2octets(h1)
+        uint8_t suffix[65];
+        suffix[0] = 0x00;
+        std::memcpy(suffix + 1, privateKey, 32);
+        u256ToBytes(z, suffix + 33);
+
+        std::memset(V_, 0x01, sizeof(V_));
+        std::memset(K_, 0x00, sizeof(K_));
+        hmac_.setKey(K_);
+
+        hmac_.mac(V_, 32, suffix, sizeof(suffix), K_);
+        hmac_.setKey(K_);
+        hmac_.mac(V_, 32, nullptr, 0, V_);
+
+        suffix[0] = 0x01;
+        hmac_.mac(V_, 32, suffix, sizeof(suffix), K_);
+        hmac_.setKey(K_);
+        hmac_.mac(V_, 32, nullptr, 0, V_);
+    }
+
+    // Next candidate scalar in (0, n); also called again when the
+    // resulting signature had r == 0 or s == 0
+    bool next(U256& k) {
+        for (int tries = 0; tries < 128; ++tries) {
+            hmac_.mac(V_, 32, nullptr, 0, V_);
+            u256FromBytes(k, V_);
+            if (!u256IsZero(k) && u256Cmp(k, ORDER_N.m) < 0) {
+                return true;
+            }
+            const uint8_t zero = 0x00;
+            hmac_.mac(V_, 32, &zero, 1, K_);
+            hmac_.setKey(K_);
+            hmac_.mac(V_, 32, nullptr, 0, V_);
+        }
+        return false;
+    }
+
+private:
+    HmacKeccak hmac_;
+    uint8_t V_[32];
+    uint8_t K_[32];
+};
+
+// Per-thread scratch so the ~8k/sec signer reuses one generator
+// instead of constructing hash state per call
+static NonceGenerator& nonceScratch() {
+    thread_local NonceGenerator generator;
+    return generator;
+}
+
+bool derivePublicKey(const uint8_t privateKey[32], uint8_t publicKey[64]) {
+    U256 d;
+    if (!loadScalar(d, privateKey)) {
+        return false;
+    }
+    Jacobian j;
+    scalarMultGFixedBase(j, d);
+    Point p;
+    jacobianToAffine(p, j);
+    if (p.infinity) {
+        return false;
+    }
+    u256ToBytes(p.x, publicKey);
+    u256ToBytes(p.y, publicKey + 32);
+    return true;
+}
+
+// Core signing loop over candidates from a seeded nonce generator
+static bool signDigest(
+    const U256& d,
+    const U256& z,
+    NonceGenerator& nonce,
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    for (uint32_t attempt = 0; attempt < 128; ++attempt) {
+        U256 k;
+        if (!nonce.next(k)) {
+            return false;
+        }
+
+        Jacobian jr;
+        scalarMultGFixedBase(jr, k);
+        Point rp;
+        jacobianToAffine(rp, jr);
+        if (rp.infinity) {
+            continue;
+        }
+
+        U256 r = rp.x;
+        const bool overflow = u256Cmp(r, ORDER_N.m) >= 0;
+        modReduce(r, ORDER_N);
+        if (u256IsZero(r)) {
+            continue;
+        }
+
+        // s = k^-1 * (z + r*d) mod n
+        U256 s, kinv;
+        modMul(s, r, d, ORDER_N);
+        modAdd(s, s, z, ORDER_N);
+        modInv(kinv, k, ORDER_N);
+        modMul(s, s, kinv, ORDER_N);
+        if (u256IsZero(s)) {
+            continue;
+        }
+
+        uint8_t recid = (u256Bit(rp.y, 0) ? 1 : 0) | (overflow ? 2 : 0);
+
+        // Canonical low-s form; negating s flips the recovered parity
+        U256 halfCheck;
+        u256Sub(halfCheck, ORDER_N.m, s);
+        if (u256Cmp(s, halfCheck) > 0) {
+            s = halfCheck;
+            recid ^= 1;
+        }
+
+        u256ToBytes(r, signature);
+        u256ToBytes(s, signature + 32);
+        if (recoveryId) {
+            *recoveryId = recid;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool sign(
+    const uint8_t privateKey[32],
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    U256 d;
+    if (!loadScalar(d, privateKey)) {
+        return false;
+    }
+
+    U256 z;
+    u256FromBytes(z, messageHash);
+    modReduce(z, ORDER_N);
+
+    NonceGenerator& nonce = nonceScratch();
+    nonce.seed(privateKey, z);
+    return signDigest(d, z, nonce, signature, recoveryId);
+}
+
+bool signBatch(
+    const uint8_t privateKey[32],
+    const uint8_t (*hashes)[32],
+    size_t count,
+    uint8_t* signatures,
+    uint8_t* recoveryIds
+) {
+    U256 d;
+    if (!loadScalar(d, privateKey)) {
+        return false;
+    }
+    ensureGeneratorPrecomp();
+
+    NonceGenerator& nonce = nonceScratch();
+    for (size_t i = 0; i < count; ++i) {
+        U256 z;
+        u256FromBytes(z, hashes[i]);
+        modReduce(z, ORDER_N);
+        nonce.seed(privateKey, z);
+        if (!signDigest(d, z, nonce, signatures + i * 64,
+                        recoveryIds ? recoveryIds + i : nullptr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool verify(
+    const uint8_t publicKey[64],
+    const uint8_t messageHash[32],
+    const uint8_t signature[64]
+) {
+    Point q;
+    if (!loadPublicKey(q, publicKey)) {
+        return false;
+    }
+
+    U256 r, s;
+    if (!loadScalar(r, signature) || !loadScalar(s, signature + 32)) {
+        return false;
+    }
+
+    U256 z;
+    u256FromBytes(z, messageHash);
+    modReduce(z, ORDER_N);
+
+    U256 sinv, u1, u2;
+    modInv(sinv, s, ORDER_N);
+    modMul(u1, z, sinv, ORDER_N);
+    modMul(u2, r, sinv, ORDER_N);
+
+    Jacobian a;
+    doubleScalarMultG(a, u1, q, u2);
+
+    Point rp;
+    jacobianToAffine(rp, a);
+    if (rp.infinity) {
+        return false;
+    }
+
+    modReduce(rp.x, ORDER_N);
+    return u256Cmp(rp.x, r) == 0;
+}
+
+bool recoverPublicKey(
+    const uint8_t messageHash[32],
+    const uint8_t signature[64],
+    uint8_t recoveryId,
+    uint8_t publicKey[64]
+) {
+    if (recoveryId > 3) {
+        return false;
+    }
+
+    U256 r, s;
+    if (!loadScalar(r, signature) || !loadScalar(s, signature + 32)) {
+        return false;
+    }
+
+    // Reconstruct R from r (optionally shifted by n) and the parity bit
+    U256 x = r;
+    if (recoveryId & 2) {
+        if (u256Add(x, x, ORDER_N.m) || u256Cmp(x, FIELD_P.m) >= 0) {
+            return false;
+        }
+    }
+
+    U256 alpha;
+    modSqr(alpha, x, FIELD_P);
+    modMul(alpha, alpha, x, FIELD_P);
+    const U256 seven = {{7, 0, 0, 0}};
+    modAdd(alpha, alpha, seven, FIELD_P);
+
+    U256 y;
+    if (!fieldSqrt(y, alpha)) {
+        return false;
+    }
+    if ((u256Bit(y, 0) ? 1 : 0) != (recoveryId & 1)) {
+        modSub(y, FIELD_P.m, y, FIELD_P);
+    }
+
+    Point rPoint = {x, y, false};
+
+    // Q = r^-1 * (s*R - z*G)
+    U256 z;
+    u256FromBytes(z, messageHash);
+    modReduce(z, ORDER_N);
+
+    U256 rinv, u1, u2;
+    modInv(rinv, r, ORDER_N);
+    modMul(u2, s, rinv, ORDER_N);
+    modMul(u1, z, rinv, ORDER_N);
+    if (!u256IsZero(u1)) {
+        modSub(u1, ORDER_N.m, u1, ORDER_N);     // -z * r^-1
+    }
+
+    Jacobian a;
+    doubleScalarMultG(a, u1, rPoint, u2);
+
+    Point q;
+    jacobianToAffine(q, a);
+    if (q.infinity) {
+        return false;
+    }
+
+    u256ToBytes(q.x, publicKey);
+    u256ToBytes(q.y, publicKey + 32);
+    return true;
+}
+
+} // namespace ec
+} // namespace crypto
+} // namespace whisper
@@ -0,0 +1,202 @@
+#ifndef WHISPER_CRYPTO_SECP256K1_MATH_H
+#define WHISPER_CRYPTO_SECP256K1_MATH_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace whisper {
+namespace crypto {
+namespace ec {
+
+/**
+ * @brief 256-bit unsigned integer, four little-endian 64-bit limbs
+ */
+struct U256 {
+    uint64_t w[4];
+};
+
+/**
+ * @brief Affine point on secp256k1 (y^2 = x^3 + 7 over F_p)
+ */
+struct Point {
+    U256 x;
+    U256 y;
+    bool infinity;
+};
+
+/**
+ * @brief Jacobian-projective point (x/z^2, y/z^3)
+ */
+struct Jacobian {
+    U256 x;
+    U256 y;
+    U256 z;
+    bool infinity;
+};
+
+// --- 256-bit integer helpers -------------------------------------------------
+
+bool u256IsZero(const U256& a);
+int u256Cmp(const U256& a, const U256& b);
+void u256FromBytes(U256& r, const uint8_t bytes[32]);   // big-endian input
+void u256ToBytes(const U256& a, uint8_t bytes[32]);     // big-endian output
+
+// --- modular arithmetic ------------------------------------------------------
+
+/**
+ * @brief Modulus descriptor for the fold-based reducer
+ *
+ * fold holds 2^256 - m, so a 512-bit value lo + hi*2^256 reduces as
+ * lo + hi*fold (mod m); for secp256k1's field and group order the fold
+ * constant is tiny (33 and 129 bits), so reduction is a few multiplies.
+ */
+struct Mod {
+    U256 m;
+    uint64_t fold[3];
+    int foldLimbs;
+};
+
+extern const Mod FIELD_P;   // curve field prime
+extern const Mod ORDER_N;   // group order
+extern const Point G;       // generator
+
+void modAdd(U256& r, const U256& a, const U256& b, const Mod& mod);
+void modSub(U256& r, const U256& a, const U256& b, const Mod& mod);
+void modMul(U256& r, const U256& a, const U256& b, const Mod& mod);
+void modSqr(U256& r, const U256& a, const Mod& mod);
+void modPow(U256& r, const U256& base, const U256& exp, const Mod& mod);
+void modInv(U256& r, const U256& a, const Mod& mod);
+void modReduce(U256& r, const Mod& mod);                 // r < 2^256 -> r mod m
+
+// --- group operations --------------------------------------------------------
+
+void jacobianFromAffine(Jacobian& r, const Point& p);
+void jacobianDouble(Jacobian& r, const Jacobian& p);
+void jacobianAdd(Jacobian& r, const Jacobian& p, const Jacobian& q);
+void jacobianAddAffine(Jacobian& r, const Jacobian& p, const Point& q);
+void jacobianToAffine(Point& r, const Jacobian& p);
+
+/**
+ * @brief Windowed scalar multiplication k * base
+ */
+void scalarMult(Jacobian& r, const Point& base, const U256& k);
+
+/**
+ * @brief k * G over the generator
+ */
+void scalarMultG(Jacobian& r, const U256& k);
+
+/**
+ * @brief k * G via a precomputed fixed-base comb table
+ *
+ * Uses a process-wide table of d * 16^w * G multiples (built on first
+ * use), reducing a generator multiplication to 64 mixed additions with
+ * no doublings. This is the signing hot path.
+ */
+void scalarMultGFixedBase(Jacobian& r, const U256& k);
+
+/**
+ * @brief Force construction of the fixed-base generator table
+ *
+ * Lets long-lived signers pay the one-time table build at setup
+ * instead of on the first signature.
+ */
+void ensureGeneratorPrecomp();
+
+/**
+ * @brief Strauss/Shamir combined multiplication u1*G + u2*q
+ *
+ * Interleaves both scalars over one shared doubling chain, so an ECDSA
+ * verification costs roughly half the doublings of two separate
+ * multiplications.
+ */
+void doubleScalarMultG(Jacobian& r, const U256& u1, const Point& q, const U256& u2);
+
+/**
+ * @brief Check that (x, y) satisfies the curve equation
+ */
+bool isOnCurve(const Point& p);
+
+// --- ECDSA -------------------------------------------------------------------
+
+/**
+ * @brief Derive the 64-byte uncompressed public key for a private key
+ * @return false if the private key is zero or not below the group order
+ */
+bool derivePublicKey(const uint8_t privateKey[32], uint8_t publicKey[64]);
+
+/**
+ * @brief Serialize a 64-byte public key as x plus a parity prefix
+ *
+ * The prefix is 0x02 for even y, 0x03 for odd.
+ */
+void compressPublicKey(const uint8_t publicKey[64], uint8_t compressed[33]);
+
+/**
+ * @brief Recover the full point from a 33-byte compressed key
+ *
+ * Costs one field square root; returns false for a bad prefix or an x
+ * with no point on the curve.
+ */
+bool decompressPublicKey(const uint8_t compressed[33], uint8_t publicKey[64]);
+
+/**
+ * @brief ECDSA sign with an RFC 6979-style deterministic nonce, low-s
+ *
+ * Nonce derivation follows RFC 6979's HMAC-DRBG with Keccak-256 as the
+ * HMAC hash (deterministic, but not the RFC's SHA-2 test vectors), so
+ * replicas produce byte-identical signatures. The generator state is
+ * per-thread scratch, reused across calls.
+ *
+ * @param signature r || s, each 32 bytes big-endian
+ * @param recoveryId 0-3, as used by Ethereum's ecrecover
+ */
+bool sign(
+    const uint8_t privateKey[32],
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+);
+
+/**
+ * @brief Sign many hashes with one key
+ *
+ * Amortizes the scalar validation and fixed-base table setup across
+ * the batch; output for each hash is identical to sign().
+ *
+ * @param signatures Receives count * 64 bytes
+ * @param recoveryIds Receives count recovery IDs; may be null
+ * @return false if the key is invalid (nothing is written then)
+ */
+bool signBatch(
+    const uint8_t privateKey[32],
+    const uint8_t (*hashes)[32],
+    size_t count,
+    uint8_t* signatures,
+    uint8_t* recoveryIds
+);
+
+/**
+ * @brief ECDSA verify against a 64-byte uncompressed public key
+ */
+bool verify(
+    const uint8_t publicKey[64],
+    const uint8_t messageHash[32],
+    const uint8_t signature[64]
+);
+
+/**
+ * @brief Recover the signing public key from a signature and recovery ID
+ */
+bool recoverPublicKey(
+    const uint8_t messageHash[32],
+    const uint8_t signature[64],
+    uint8_t recoveryId,
+    uint8_t publicKey[64]
+);
+
+} // namespace ec
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_SECP256K1_MATH_H
@@ -1,59 +1,151 @@
 /**
  * SECP256K1 Elliptic Curve Wrapper
  * Used for Ethereum key generation and signing
+ *
+ * Backed by libsecp256k1 when built with WHISPER_HAVE_LIBSECP256K1,
+ * otherwise by the portable arithmetic in secp256k1_math.cpp. The
+ * libsecp256k1 context is created once per wrapper and reused across
+ * all calls, since context creation is the expensive part.
  */
 
 #include "secp256k1_wrapper.h"
+#include "secp256k1_math.h"
+#include "address_cache.h"
+#include "entropy.h"
+#include "hex.h"
+#include "stats.h"
 #include <cstring>
-#include <random>
+
+#ifdef WHISPER_HAVE_LIBSECP256K1
+#include <secp256k1.h>
+#include <secp256k1_recovery.h>
+#endif
 
 namespace whisper {
 namespace crypto {
 
+#ifdef WHISPER_HAVE_LIBSECP256K1
+
+namespace {
+
+secp256k1_context* ctx(void* p) {
+    return static_cast<secp256k1_context*>(p);
+}
+
+// libsecp256k1 serializes uncompressed keys with a 0x04 prefix; the
+// wrapper API carries the raw 64-byte x||y form.
+bool serializePublicKey(secp256k1_context* c, const secp256k1_pubkey& pubkey, uint8_t out[64]) {
+    uint8_t serialized[65];
+    size_t len = sizeof(serialized);
+    if (!secp256k1_ec_pubkey_serialize(c, serialized, &len, &pubkey, SECP256K1_EC_UNCOMPRESSED)) {
+        return false;
+    }
+    std::memcpy(out, serialized + 1, 64);
+    return true;
+}
+
+bool parsePublicKey(secp256k1_context* c, secp256k1_pubkey& pubkey, const uint8_t in[64]) {
+    uint8_t serialized[65];
+    serialized[0] = 0x04;
+    std::memcpy(serialized + 1, in, 64);
+    return secp256k1_ec_pubkey_parse(c, &pubkey, serialized, sizeof(serialized)) == 1;
+}
+
+} // namespace
+
 SECP256k1Wrapper::SECP256k1Wrapper() {
-    // In production, use libsecp256k1
-    // This is a simplified demonstration
+    context_ = secp256k1_context_create(
+        SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY
+    );
 }
 
 SECP256k1Wrapper::~SECP256k1Wrapper() {
-    // Cleanup
+    if (context_) {
+        secp256k1_context_destroy(ctx(context_));
+    }
 }
 
-KeyPair SECP256k1Wrapper::generateKeyPair() {
-    KeyPair keyPair;
+bool SECP256k1Wrapper::derivePublicKey(
+    const uint8_t privateKey[32],
+    uint8_t publicKey[64]
+) {
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ec_pubkey_create(ctx(context_), &pubkey, privateKey)) {
+        return false;
+    }
+    return serializePublicKey(ctx(context_), pubkey, publicKey);
+}
 
-    // Generate random private key (32 bytes)
-    std::random_device rd;
-    std::mt19937_64 gen(rd());
-    std::uniform_int_distribution<uint8_t> dis(0, 255);
+bool SECP256k1Wrapper::sign(
+    const uint8_t privateKey[32],
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    WHISPER_STATS_SCOPE(Sign);
+    secp256k1_ecdsa_recoverable_signature sig;
+    if (!secp256k1_ecdsa_sign_recoverable(
+            ctx(context_), &sig, messageHash, privateKey, nullptr, nullptr)) {
+        return false;
+    }
+    int recid = 0;
+    secp256k1_ecdsa_recoverable_signature_serialize_compact(
+        ctx(context_), signature, &recid, &sig);
+    if (recoveryId) {
+        *recoveryId = static_cast<uint8_t>(recid);
+    }
+    return true;
+}
 
-    for (int i = 0; i < 32; ++i) {
-        keyPair.privateKey[i] = dis(gen);
+bool SECP256k1Wrapper::verify(
+    const uint8_t publicKey[64],
+    const uint8_t messageHash[32],
+    const uint8_t signature[64]
+) {
+    WHISPER_STATS_SCOPE(Verify);
+    secp256k1_pubkey pubkey;
+    if (!parsePublicKey(ctx(context_), pubkey, publicKey)) {
+        return false;
+    }
+    secp256k1_ecdsa_signature sig;
+    if (!secp256k1_ecdsa_signature_parse_compact(ctx(context_), &sig, signature)) {
+        return false;
+    }
+    return secp256k1_ecdsa_verify(ctx(context_), &sig, messageHash, &pubkey) == 1;
+}
+
+bool SECP256k1Wrapper::recoverPublicKey(
+    const uint8_t messageHash[32],
+    const uint8_t signature[64],
+    uint8_t recoveryId,
+    uint8_t publicKey[64]
+) {
+    WHISPER_STATS_SCOPE(Recover);
+    secp256k1_ecdsa_recoverable_signature sig;
+    if (!secp256k1_ecdsa_recoverable_signature_parse_compact(
+            ctx(context_), &sig, signature, recoveryId)) {
+        return false;
+    }
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ecdsa_recover(ctx(context_), &pubkey, &sig, messageHash)) {
+        return false;
     }
+    return serializePublicKey(ctx(context_), pubkey, publicKey);
+}
 
-    // Derive public key from private key
-    // In production, use libsecp256k1's secp256k1_ec_pubkey_create
-    // This is placeholder code
-    derivePublicKey(keyPair.privateKey, keyPair.publicKey);
+#else // portable built-in backend
 
-    return keyPair;
+SECP256k1Wrapper::SECP256k1Wrapper() : context_(nullptr) {
+}
+
+SECP256k1Wrapper::~SECP256k1Wrapper() {
 }
 
 bool SECP256k1Wrapper::derivePublicKey(
     const uint8_t privateKey[32],
     uint8_t publicKey[64]
 ) {
-    // In production, use:
-    // secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
-    // secp256k1_pubkey pubkey;
-    // secp256k1_ec_pubkey_create(ctx, &pubkey, privateKey);
-    // secp256k1_ec_pubkey_serialize(ctx, publicKey, &len, &pubkey, SECP256K1_EC_UNCOMPRESSED);
-
-    // Placeholder implementation
-    std::memcpy(publicKey, privateKey, 32);
-    std::memcpy(publicKey + 32, privateKey, 32);
-
-    return true;
+    return ec::derivePublicKey(privateKey, publicKey);
 }
 
 bool SECP256k1Wrapper::sign(
@@ -62,16 +154,8 @@ bool SECP256k1Wrapper::sign(
     uint8_t signature[64],
     uint8_t* recoveryId
 ) {
-    // In production, use libsecp256k1:
-    // secp256k1_ecdsa_sign_recoverable(ctx, &sig, messageHash, privateKey, NULL, NULL);
-    // secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, signature, recoveryId, &sig);
-
-    // Placeholder
-    std::memcpy(signature, messageHash, 32);
-    std::memcpy(signature + 32, privateKey, 32);
-    *recoveryId = 0;
-
-    return true;
+    WHISPER_STATS_SCOPE(Sign);
+    return ec::sign(privateKey, messageHash, signature, recoveryId);
 }
 
 bool SECP256k1Wrapper::verify(
@@ -79,13 +163,8 @@ bool SECP256k1Wrapper::verify(
     const uint8_t messageHash[32],
     const uint8_t signature[64]
 ) {
-    // In production, use libsecp256k1:
-    // secp256k1_ecdsa_signature sig;
-    // secp256k1_ecdsa_signature_parse_compact(ctx, &sig, signature);
-    // return secp256k1_ecdsa_verify(ctx, &sig, messageHash, &pubkey);
-
-    // Placeholder
-    return true;
+    WHISPER_STATS_SCOPE(Verify);
+    return ec::verify(publicKey, messageHash, signature);
 }
 
 bool SECP256k1Wrapper::recoverPublicKey(
@@ -94,30 +173,286 @@ bool SECP256k1Wrapper::recoverPublicKey(
     uint8_t recoveryId,
     uint8_t publicKey[64]
 ) {
-    // In production, use libsecp256k1:
-    // secp256k1_ecdsa_recoverable_signature sig;
-    // secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig, signature, recoveryId);
-    // secp256k1_pubkey pubkey;
-    // secp256k1_ecdsa_recover(ctx, &pubkey, &sig, messageHash);
+    WHISPER_STATS_SCOPE(Recover);
+    return ec::recoverPublicKey(messageHash, signature, recoveryId, publicKey);
+}
 
-    // Placeholder
-    std::memcpy(publicKey, messageHash, 32);
-    std::memcpy(publicKey + 32, signature, 32);
+#endif // WHISPER_HAVE_LIBSECP256K1
 
+bool SECP256k1Wrapper::signBatch(
+    const uint8_t privateKey[32],
+    const uint8_t (*hashes)[32],
+    size_t count,
+    uint8_t* signatures,
+    uint8_t* recoveryIds
+) {
+#ifdef WHISPER_HAVE_LIBSECP256K1
+    // libsecp256k1 is already RFC 6979 internally; its context setup is
+    // per-wrapper, so a plain loop is the amortized form here
+    for (size_t i = 0; i < count; ++i) {
+        if (!sign(privateKey, hashes[i], signatures + i * 64,
+                  recoveryIds ? recoveryIds + i : nullptr)) {
+            return false;
+        }
+    }
     return true;
+#else
+    return ec::signBatch(privateKey, hashes, count, signatures, recoveryIds);
+#endif
 }
 
-std::string SECP256k1Wrapper::bytesToHex(const uint8_t* bytes, size_t length) {
-    static const char hex[] = "0123456789abcdef";
-    std::string result;
-    result.reserve(length * 2);
+size_t SECP256k1Wrapper::verifyBatch(
+    const VerifyJob* jobs,
+    size_t count,
+    uint64_t* results
+) {
+    WHISPER_STATS_SCOPE(VerifyBatch);
+    std::memset(results, 0, ((count + 63) / 64) * sizeof(uint64_t));
+
+    size_t valid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (verify(jobs[i].publicKey, jobs[i].messageHash, jobs[i].signature)) {
+            results[i / 64] |= uint64_t(1) << (i % 64);
+            ++valid;
+        }
+    }
+    return valid;
+}
+
+#ifdef WHISPER_HAVE_LIBSECP256K1
+
+SigningSession::SigningSession(const uint8_t privateKey[32]) {
+    std::memcpy(privateKey_, privateKey, 32);
+    context_ = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+    secp256k1_pubkey pubkey;
+    valid_ = secp256k1_ec_pubkey_create(ctx(context_), &pubkey, privateKey_) &&
+             serializePublicKey(ctx(context_), pubkey, publicKey_);
+}
 
-    for (size_t i = 0; i < length; ++i) {
-        result.push_back(hex[bytes[i] >> 4]);
-        result.push_back(hex[bytes[i] & 0x0F]);
+SigningSession::~SigningSession() {
+    std::memset(privateKey_, 0, sizeof(privateKey_));
+    if (context_) {
+        secp256k1_context_destroy(ctx(context_));
     }
+}
 
-    return result;
+bool SigningSession::sign(
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    if (!valid_) {
+        return false;
+    }
+    secp256k1_ecdsa_recoverable_signature sig;
+    if (!secp256k1_ecdsa_sign_recoverable(
+            ctx(context_), &sig, messageHash, privateKey_, nullptr, nullptr)) {
+        return false;
+    }
+    int recid = 0;
+    secp256k1_ecdsa_recoverable_signature_serialize_compact(
+        ctx(context_), signature, &recid, &sig);
+    if (recoveryId) {
+        *recoveryId = static_cast<uint8_t>(recid);
+    }
+    return true;
+}
+
+#else
+
+SigningSession::SigningSession(const uint8_t privateKey[32]) : context_(nullptr) {
+    std::memcpy(privateKey_, privateKey, 32);
+    valid_ = ec::derivePublicKey(privateKey_, publicKey_);
+    if (valid_) {
+        ec::ensureGeneratorPrecomp();
+    }
+}
+
+SigningSession::~SigningSession() {
+    std::memset(privateKey_, 0, sizeof(privateKey_));
+}
+
+bool SigningSession::sign(
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    if (!valid_) {
+        return false;
+    }
+    return ec::sign(privateKey_, messageHash, signature, recoveryId);
+}
+
+#endif // WHISPER_HAVE_LIBSECP256K1
+
+KeyPair SECP256k1Wrapper::generateKeyPair() {
+    KeyPair keyPair;
+    generateKeyPairs(&keyPair, 1);
+    return keyPair;
+}
+
+void SECP256k1Wrapper::generateKeyPairs(KeyPair* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        // Retry until the candidate is a valid scalar for the curve
+        do {
+            entropy::randomBytes(out[i].privateKey, 32);
+        } while (!derivePublicKey(out[i].privateKey, out[i].publicKey));
+    }
+}
+
+void SECP256k1Wrapper::compress(const uint8_t publicKey[64], uint8_t compressed[33]) {
+    ec::compressPublicKey(publicKey, compressed);
+}
+
+bool SECP256k1Wrapper::decompress(const uint8_t compressed[33], uint8_t publicKey[64]) {
+    return ec::decompressPublicKey(compressed, publicKey);
+}
+
+bool SECP256k1Wrapper::decompressCached(
+    const uint8_t compressed[33],
+    uint8_t publicKey[64]
+) {
+    if (decompressCache_.empty()) {
+        decompressCache_.resize(DECOMPRESS_CACHE_CAPACITY);
+        for (DecompressEntry& entry : decompressCache_) {
+            entry.used = false;
+            entry.referenced = false;
+        }
+    }
+    const size_t mask = decompressCache_.size() - 1;
+
+    // The x coordinate is a field element, already uniform; fold two
+    // words for the table index
+    uint64_t a, b;
+    std::memcpy(&a, compressed + 1, 8);
+    std::memcpy(&b, compressed + 17, 8);
+    const size_t home = static_cast<size_t>(a ^ (b * 0x9E3779B97F4A7C15ULL)) & mask;
+
+    size_t freeSlot = SIZE_MAX;
+    for (size_t i = 0; i < DECOMPRESS_PROBE_WINDOW; ++i) {
+        DecompressEntry& entry = decompressCache_[(home + i) & mask];
+        if (!entry.used) {
+            if (freeSlot == SIZE_MAX) {
+                freeSlot = (home + i) & mask;
+            }
+            continue;
+        }
+        if (std::memcmp(entry.compressed, compressed, 33) == 0) {
+            entry.referenced = true;
+            std::memcpy(publicKey, entry.publicKey, 64);
+            return true;
+        }
+    }
+
+    if (!ec::decompressPublicKey(compressed, publicKey)) {
+        return false;
+    }
+
+    size_t victim = freeSlot;
+    if (victim == SIZE_MAX) {
+        victim = home;
+        for (size_t i = 0; i < DECOMPRESS_PROBE_WINDOW; ++i) {
+            DecompressEntry& entry = decompressCache_[(home + i) & mask];
+            if (!entry.referenced) {
+                victim = (home + i) & mask;
+                break;
+            }
+            entry.referenced = false;  // second chance
+        }
+    }
+
+    DecompressEntry& entry = decompressCache_[victim];
+    std::memcpy(entry.compressed, compressed, 33);
+    std::memcpy(entry.publicKey, publicKey, 64);
+    entry.used = true;
+    entry.referenced = false;
+    return true;
+}
+
+bool SECP256k1Wrapper::verifyCompressed(
+    const uint8_t compressedKey[33],
+    const uint8_t messageHash[32],
+    const uint8_t signature[64]
+) {
+    uint8_t publicKey[64];
+    if (!decompressCached(compressedKey, publicKey)) {
+        return false;
+    }
+    return verify(publicKey, messageHash, signature);
+}
+
+bool SECP256k1Wrapper::recoverPublicKeyCompressed(
+    const uint8_t messageHash[32],
+    const uint8_t signature[64],
+    uint8_t recoveryId,
+    uint8_t compressedKey[33]
+) {
+    uint8_t publicKey[64];
+    if (!recoverPublicKey(messageHash, signature, recoveryId, publicKey)) {
+        return false;
+    }
+    ec::compressPublicKey(publicKey, compressedKey);
+    return true;
+}
+
+bool SECP256k1Wrapper::verifyAgainstAddress(
+    const uint8_t messageHash[32],
+    const uint8_t signature[64],
+    uint8_t recoveryId,
+    const uint8_t expectedAddress[20]
+) {
+    uint8_t publicKey[64];
+    if (!recoverPublicKey(messageHash, signature, recoveryId, publicKey)) {
+        return false;
+    }
+    if (!addressCache_) {
+        addressCache_.reset(new AddressCache());
+    }
+    uint8_t address[AddressCache::ADDRESS_SIZE];
+    addressCache_->deriveAddress(publicKey, address);
+    return std::memcmp(address, expectedAddress, AddressCache::ADDRESS_SIZE) == 0;
+}
+
+SecretKey SECP256k1Wrapper::generateSecretKey(uint8_t publicKey[64]) {
+    SecretKey key = SecretKey::uninitialized();
+    if (key.empty()) {
+        return key;
+    }
+    do {
+        entropy::randomBytes(key.data(), SecretKey::SIZE);
+    } while (!derivePublicKey(key.data(), publicKey));
+    return key;
+}
+
+bool SECP256k1Wrapper::derivePublicKey(const SecretKey& privateKey, uint8_t publicKey[64]) {
+    if (privateKey.empty()) {
+        return false;
+    }
+    return derivePublicKey(privateKey.data(), publicKey);
+}
+
+bool SECP256k1Wrapper::sign(
+    const SecretKey& privateKey,
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    if (privateKey.empty()) {
+        return false;
+    }
+    return sign(privateKey.data(), messageHash, signature, recoveryId);
+}
+
+std::string SECP256k1Wrapper::bytesToHex(const uint8_t* bytes, size_t length) {
+    return hex::encodeString(bytes, length);
+}
+
+std::string_view SECP256k1Wrapper::bytesToHex(
+    const uint8_t* bytes,
+    size_t length,
+    Arena& arena
+) {
+    return hex::encodeView(bytes, length, arena);
 }
 
 } // namespace crypto
@@ -2,11 +2,19 @@
 #define WHISPER_CRYPTO_SECP256K1_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "secret_key.h"
 
 namespace whisper {
 namespace crypto {
 
+class AddressCache;
+class Arena;
+
 /**
  * @brief Key pair for SECP256k1 elliptic curve
  */
@@ -15,6 +23,15 @@ struct KeyPair {
     uint8_t publicKey[64];
 };
 
+/**
+ * @brief One signature verification request for verifyBatch
+ */
+struct VerifyJob {
+    const uint8_t* publicKey;    ///< 64-byte uncompressed public key
+    const uint8_t* messageHash;  ///< 32-byte message hash
+    const uint8_t* signature;    ///< 64-byte compact signature
+};
+
 /**
  * @brief Wrapper for SECP256k1 cryptographic operations
  *
@@ -35,6 +52,18 @@ public:
      */
     KeyPair generateKeyPair();
 
+    /**
+     * @brief Generate many key pairs in one call
+     *
+     * Draws all private keys from the calling thread's pooled ChaCha20
+     * CSPRNG, amortizing OS entropy syscalls across the batch; the
+     * single-key generateKeyPair is a thin wrapper over this.
+     *
+     * @param out Receives count key pairs
+     * @param count Number of key pairs to generate
+     */
+    void generateKeyPairs(KeyPair* out, size_t count);
+
     /**
      * @brief Derive public key from private key
      * @param privateKey 32-byte private key
@@ -58,6 +87,28 @@ public:
         uint8_t* recoveryId
     );
 
+    /**
+     * @brief Sign many message hashes with one key
+     *
+     * Deterministic (RFC 6979-style) like sign(), with the per-key
+     * setup and nonce-generator scratch amortized across the batch;
+     * each signature is byte-identical to a lone sign() call.
+     *
+     * @param privateKey Signer's private key
+     * @param hashes count 32-byte message hashes
+     * @param count Number of hashes
+     * @param signatures Receives count * 64 bytes
+     * @param recoveryIds Receives count recovery IDs; may be null
+     * @return true when every hash was signed
+     */
+    bool signBatch(
+        const uint8_t privateKey[32],
+        const uint8_t (*hashes)[32],
+        size_t count,
+        uint8_t* signatures,
+        uint8_t* recoveryIds
+    );
+
     /**
      * @brief Verify a signature
      * @param publicKey Signer's public key
@@ -71,6 +122,81 @@ public:
         const uint8_t signature[64]
     );
 
+    /**
+     * @brief Verify against a 33-byte compressed public key
+     *
+     * Decompression costs a field square root, so the expanded point is
+     * cached per wrapper and repeat senders skip the sqrt entirely.
+     * Wrappers are used one per thread (as in WorkPool), so the cache
+     * needs no locking.
+     */
+    bool verifyCompressed(
+        const uint8_t compressedKey[33],
+        const uint8_t messageHash[32],
+        const uint8_t signature[64]
+    );
+
+    /**
+     * @brief Recover the signing key in 33-byte compressed wire form
+     */
+    bool recoverPublicKeyCompressed(
+        const uint8_t messageHash[32],
+        const uint8_t signature[64],
+        uint8_t recoveryId,
+        uint8_t compressedKey[33]
+    );
+
+    /**
+     * @brief Serialize a 64-byte public key to compressed form
+     */
+    static void compress(const uint8_t publicKey[64], uint8_t compressed[33]);
+
+    /**
+     * @brief Expand a 33-byte compressed key (uncached)
+     * @return false for a malformed key
+     */
+    static bool decompress(const uint8_t compressed[33], uint8_t publicKey[64]);
+
+    /**
+     * @brief Generate a key into pooled, locked storage
+     *
+     * Preferred over generateKeyPair for long-lived keys: the private
+     * key never exists outside the SecretKey pool.
+     *
+     * @param publicKey Receives the 64-byte public key
+     */
+    SecretKey generateSecretKey(uint8_t publicKey[64]);
+
+    /**
+     * @brief Derive the public key for a pooled private key
+     */
+    bool derivePublicKey(const SecretKey& privateKey, uint8_t publicKey[64]);
+
+    /**
+     * @brief Sign a message hash with a pooled private key
+     */
+    bool sign(
+        const SecretKey& privateKey,
+        const uint8_t messageHash[32],
+        uint8_t signature[64],
+        uint8_t* recoveryId
+    );
+
+    /**
+     * @brief Verify many signatures in one call
+     *
+     * Each verification runs a Strauss/Shamir combined double-scalar
+     * multiplication (one shared doubling chain for u1*G + u2*Q), so a
+     * batch of N costs well under N single verifies. Result bit i is
+     * set in results[i / 64] when job i verified.
+     *
+     * @param jobs Array of count verification requests
+     * @param count Number of requests
+     * @param results Output bitmask, (count + 63) / 64 words
+     * @return Number of signatures that verified
+     */
+    size_t verifyBatch(const VerifyJob* jobs, size_t count, uint64_t* results);
+
     /**
      * @brief Recover public key from signature
      * @param messageHash Original message hash
@@ -86,10 +212,107 @@ public:
         uint8_t publicKey[64]
     );
 
+    /**
+     * @brief Verify a signature against a known sender address
+     *
+     * Session-layer fast path: when the expected 20-byte sender address
+     * is already known, recovering the key and comparing its derived
+     * address is one curve operation instead of parse + verify. Address
+     * derivation goes through a per-wrapper AddressCache, so repeat
+     * senders skip the Keccak as well.
+     *
+     * @param messageHash 32-byte message hash
+     * @param signature 64-byte compact signature
+     * @param recoveryId Recovery ID (0-3)
+     * @param expectedAddress Expected 20-byte sender address
+     * @return true when the signature recovers to the expected address
+     */
+    bool verifyAgainstAddress(
+        const uint8_t messageHash[32],
+        const uint8_t signature[64],
+        uint8_t recoveryId,
+        const uint8_t expectedAddress[20]
+    );
+
     /**
      * @brief Convert bytes to hex string
      */
     static std::string bytesToHex(const uint8_t* bytes, size_t length);
+
+    /**
+     * @brief Hex-encode into arena storage, allocation-free
+     *
+     * The view lives until the arena is rewound past the allocation.
+     */
+    static std::string_view bytesToHex(const uint8_t* bytes, size_t length, Arena& arena);
+
+private:
+    // Point-decompression cache, same open-addressing clock scheme as
+    // AddressCache; sized lazily on the first compressed-key call
+    static constexpr size_t DECOMPRESS_CACHE_CAPACITY = 1024;
+    static constexpr size_t DECOMPRESS_PROBE_WINDOW = 8;
+
+    struct DecompressEntry {
+        uint8_t compressed[33];
+        uint8_t publicKey[64];
+        bool used;
+        bool referenced;
+    };
+
+    bool decompressCached(const uint8_t compressed[33], uint8_t publicKey[64]);
+
+    std::vector<DecompressEntry> decompressCache_;
+
+    // Address derivation cache for verifyAgainstAddress, built on the
+    // first call
+    std::unique_ptr<AddressCache> addressCache_;
+
+    // Long-lived libsecp256k1 context (sign + verify capabilities),
+    // created once in the constructor because building its precomputed
+    // tables dominates per-call cost. Null when the portable built-in
+    // backend is in use.
+    void* context_;
+};
+
+/**
+ * @brief Precomputed signing state for a hot key
+ *
+ * Gateways sign every outbound receipt with the same node key; a
+ * session validates and parses the key once, caches the derived public
+ * key, and forces the fixed-base generator tables to be built at
+ * construction, so the per-call hot path is just the nonce commitment
+ * additions and one scalar inversion. The stateless
+ * SECP256k1Wrapper::sign remains for cold keys.
+ */
+class SigningSession {
+public:
+    /**
+     * @brief Build a session for a private key
+     *
+     * Check valid() before signing; an out-of-range key yields an
+     * unusable session.
+     */
+    explicit SigningSession(const uint8_t privateKey[32]);
+    ~SigningSession();
+
+    SigningSession(const SigningSession&) = delete;
+    SigningSession& operator=(const SigningSession&) = delete;
+
+    bool valid() const { return valid_; }
+
+    /// Cached 64-byte public key for the session key
+    const uint8_t* publicKey() const { return publicKey_; }
+
+    /**
+     * @brief Sign a message hash with the session key
+     */
+    bool sign(const uint8_t messageHash[32], uint8_t signature[64], uint8_t* recoveryId);
+
+private:
+    uint8_t privateKey_[32];
+    uint8_t publicKey_[64];
+    bool valid_;
+    void* context_;
 };
 
 } // namespace crypto
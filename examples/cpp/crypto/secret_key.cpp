@@ -0,0 +1,149 @@
+/**
+ * Pooled, locked storage for private keys
+ */
+
+#include "secret_key.h"
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define WHISPER_HAVE_MLOCK 1
+#endif
+
+namespace whisper {
+namespace crypto {
+
+void secureErase(void* data, size_t length) {
+#if defined(__GLIBC__)
+    explicit_bzero(data, length);
+#else
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        p[i] = 0;
+    }
+#endif
+}
+
+namespace {
+
+/**
+ * Arena of locked pages carved into SecretKey::SIZE slots. Pages are
+ * mlock'd and excluded from core dumps on allocation and never
+ * returned to the OS; freed slots are zeroized and recycled.
+ */
+class KeyArena {
+public:
+    uint8_t* acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (freeList_.empty()) {
+            grow();
+        }
+        if (freeList_.empty()) {
+            return nullptr;
+        }
+        uint8_t* slot = freeList_.back();
+        freeList_.pop_back();
+        return slot;
+    }
+
+    void release(uint8_t* slot) {
+        secureErase(slot, SecretKey::SIZE);
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeList_.push_back(slot);
+    }
+
+    static KeyArena& instance() {
+        static KeyArena arena;
+        return arena;
+    }
+
+private:
+    void grow() {
+#ifdef WHISPER_HAVE_MLOCK
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        void* page = mmap(nullptr, pageSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (page == MAP_FAILED) {
+            return;
+        }
+        // Best-effort hardening; the pool is still usable when the
+        // RLIMIT_MEMLOCK budget is exhausted
+        mlock(page, pageSize);
+#ifdef MADV_DONTDUMP
+        madvise(page, pageSize, MADV_DONTDUMP);
+#endif
+        uint8_t* base = static_cast<uint8_t*>(page);
+        for (size_t offset = 0; offset + SecretKey::SIZE <= pageSize;
+             offset += SecretKey::SIZE) {
+            freeList_.push_back(base + offset);
+        }
+#else
+        uint8_t* block = new uint8_t[64 * SecretKey::SIZE];
+        for (size_t i = 0; i < 64; ++i) {
+            freeList_.push_back(block + i * SecretKey::SIZE);
+        }
+#endif
+    }
+
+    std::mutex mutex_;
+    std::vector<uint8_t*> freeList_;
+};
+
+} // namespace
+
+SecretKey::SecretKey() : slot_(nullptr) {
+}
+
+SecretKey SecretKey::uninitialized() {
+    return SecretKey(KeyArena::instance().acquire());
+}
+
+SecretKey SecretKey::fromBytes(const uint8_t bytes[SIZE]) {
+    SecretKey key = uninitialized();
+    if (!key.empty()) {
+        std::memcpy(key.slot_, bytes, SIZE);
+    }
+    return key;
+}
+
+SecretKey::~SecretKey() {
+    reset();
+}
+
+SecretKey::SecretKey(SecretKey&& other) noexcept : slot_(other.slot_) {
+    other.slot_ = nullptr;
+}
+
+SecretKey& SecretKey::operator=(SecretKey&& other) noexcept {
+    if (this != &other) {
+        reset();
+        slot_ = other.slot_;
+        other.slot_ = nullptr;
+    }
+    return *this;
+}
+
+void SecretKey::reset() {
+    if (slot_ != nullptr) {
+        KeyArena::instance().release(slot_);
+        slot_ = nullptr;
+    }
+}
+
+bool SecretKey::constantTimeEquals(const SecretKey& other) const {
+    if (empty() || other.empty()) {
+        return empty() == other.empty();
+    }
+    uint8_t acc = 0;
+    for (size_t i = 0; i < SIZE; ++i) {
+        acc |= static_cast<uint8_t>(slot_[i] ^ other.slot_[i]);
+    }
+    return acc == 0;
+}
+
+} // namespace crypto
+} // namespace whisper
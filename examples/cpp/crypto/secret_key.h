@@ -0,0 +1,77 @@
+#ifndef WHISPER_CRYPTO_SECRET_KEY_H
+#define WHISPER_CRYPTO_SECRET_KEY_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Move-only handle to pooled, locked private key storage
+ *
+ * Key bytes live in an arena of mlock'd, MADV_DONTDUMP pages rather
+ * than on stacks or the general heap: they cannot be swapped out,
+ * never appear in core dumps, and the slot is zeroized when the handle
+ * releases it. Handles are move-only so a key has exactly one owner,
+ * and comparisons are constant-time.
+ *
+ * Pool slots are recycled, so churning thousands of session keys does
+ * not fault in fresh pages.
+ */
+class SecretKey {
+public:
+    static constexpr size_t SIZE = 32;
+
+    /// Empty handle (no storage)
+    SecretKey();
+
+    /**
+     * @brief Copy 32 key bytes into a pooled slot
+     *
+     * The caller should wipe its own copy of the bytes afterwards.
+     */
+    static SecretKey fromBytes(const uint8_t bytes[SIZE]);
+
+    /**
+     * @brief Allocate an uninitialized pooled slot
+     */
+    static SecretKey uninitialized();
+
+    ~SecretKey();
+
+    SecretKey(SecretKey&& other) noexcept;
+    SecretKey& operator=(SecretKey&& other) noexcept;
+    SecretKey(const SecretKey&) = delete;
+    SecretKey& operator=(const SecretKey&) = delete;
+
+    bool empty() const { return slot_ == nullptr; }
+
+    /// Key bytes, or null for an empty handle
+    const uint8_t* data() const { return slot_; }
+    uint8_t* data() { return slot_; }
+
+    /**
+     * @brief Constant-time equality; empty handles compare equal
+     */
+    bool constantTimeEquals(const SecretKey& other) const;
+
+    /**
+     * @brief Zeroize and return the slot to the pool
+     */
+    void reset();
+
+private:
+    explicit SecretKey(uint8_t* slot) : slot_(slot) {}
+    uint8_t* slot_;
+};
+
+/**
+ * @brief Best-effort memory wipe the optimizer cannot elide
+ */
+void secureErase(void* data, size_t length);
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_SECRET_KEY_H
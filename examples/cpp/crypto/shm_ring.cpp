@@ -0,0 +1,444 @@
+/**
+ * Shared-memory verification ring
+ *
+ * Segment layout: Header, then capacity cache-line-aligned request
+ * slots, then capacity completion cells. Slot hand-off is the Vyukov
+ * bounded-MPMC scheme (per-slot sequence numbers, no locks); the
+ * server parks on a futex doorbell when the ring is empty and each
+ * waiting client parks on its completion cell's state word.
+ */
+
+#include "shm_ring.h"
+#include "secp256k1_wrapper.h"
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <sched.h>
+
+namespace whisper {
+namespace crypto {
+
+namespace {
+
+constexpr uint32_t RING_MAGIC = 0x57524E47;  // "WRNG"
+constexpr size_t MAX_BATCH = 64;
+
+// Completion cell states
+constexpr uint32_t CELL_FREE = 0;
+constexpr uint32_t CELL_PENDING = 1;
+constexpr uint32_t CELL_DONE = 2;
+
+struct alignas(64) Slot {
+    std::atomic<uint64_t> sequence;
+    RingOp op;
+    uint32_t completion;         // index of the waiter's completion cell
+    uint8_t key[64];             // public key (verify) or private key (sign)
+    uint8_t messageHash[32];
+    uint8_t signature[64];
+};
+
+/// Plain copy of a request, used once a slot has been consumed
+struct Request {
+    RingOp op;
+    uint32_t completion;
+    uint8_t key[64];
+    uint8_t messageHash[32];
+    uint8_t signature[64];
+};
+
+struct alignas(64) Completion {
+    std::atomic<uint32_t> state; // futex word the client parks on
+    uint8_t ok;
+    uint8_t recoveryId;
+    uint8_t signature[64];
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t capacity;           // power of two
+    alignas(64) std::atomic<uint64_t> enqueue;
+    alignas(64) std::atomic<uint64_t> dequeue;
+    alignas(64) std::atomic<uint32_t> doorbell;
+    std::atomic<uint32_t> stop;
+};
+
+size_t segmentSize(size_t capacity) {
+    return sizeof(Header) + capacity * (sizeof(Slot) + sizeof(Completion));
+}
+
+Slot* slots(void* base) {
+    return reinterpret_cast<Slot*>(static_cast<uint8_t*>(base) + sizeof(Header));
+}
+
+Completion* completions(void* base, size_t capacity) {
+    return reinterpret_cast<Completion*>(
+        reinterpret_cast<uint8_t*>(slots(base)) + capacity * sizeof(Slot));
+}
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#ifdef __linux__
+    syscall(SYS_futex, &word, FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+    if (word.load(std::memory_order_acquire) == expected) {
+        sched_yield();
+    }
+#endif
+}
+
+void futexWake(std::atomic<uint32_t>& word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, &word, FUTEX_WAKE, count, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+// Claim a slot, write the request, publish it and ring the doorbell.
+// Spins (yielding) while the ring is full: backpressure.
+void enqueueRequest(
+    Header* header,
+    RingOp op,
+    uint32_t completion,
+    const uint8_t* key,
+    const uint8_t messageHash[32],
+    const uint8_t* signature
+) {
+    Slot* ring = slots(header);
+    const uint64_t mask = header->capacity - 1;
+
+    uint64_t pos = header->enqueue.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring[pos & mask];
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        const int64_t dif = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+        if (dif == 0) {
+            if (header->enqueue.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                slot.op = op;
+                slot.completion = completion;
+                std::memcpy(slot.key, key, op == RingOp::Sign ? 32 : 64);
+                std::memcpy(slot.messageHash, messageHash, 32);
+                if (signature) {
+                    std::memcpy(slot.signature, signature, 64);
+                }
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                break;
+            }
+        } else if (dif < 0) {
+            sched_yield();  // full
+            pos = header->enqueue.load(std::memory_order_relaxed);
+        } else {
+            pos = header->enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    header->doorbell.fetch_add(1, std::memory_order_release);
+    futexWake(header->doorbell, 1);
+}
+
+bool dequeueRequest(Header* header, Request& out) {
+    Slot* ring = slots(header);
+    const uint64_t mask = header->capacity - 1;
+
+    uint64_t pos = header->dequeue.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring[pos & mask];
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        const int64_t dif =
+            static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+        if (dif == 0) {
+            if (header->dequeue.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                out.op = slot.op;
+                out.completion = slot.completion;
+                std::memcpy(out.key, slot.key, 64);
+                std::memcpy(out.messageHash, slot.messageHash, 32);
+                std::memcpy(out.signature, slot.signature, 64);
+                slot.sequence.store(pos + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (dif < 0) {
+            return false;  // empty
+        } else {
+            pos = header->dequeue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Claim any free completion cell; the cell doubles as the futex the
+// caller parks on
+uint32_t claimCompletion(Header* header) {
+    Completion* cells = completions(header, header->capacity);
+    for (;;) {
+        for (uint32_t i = 0; i < header->capacity; ++i) {
+            uint32_t expected = CELL_FREE;
+            if (cells[i].state.compare_exchange_strong(
+                    expected, CELL_PENDING, std::memory_order_acquire)) {
+                return i;
+            }
+        }
+        sched_yield();
+    }
+}
+
+} // namespace
+
+// --- server ------------------------------------------------------------------
+
+VerifyRingServer::VerifyRingServer() : base_(nullptr), size_(0), fd_(-1) {
+    name_[0] = '\0';
+}
+
+VerifyRingServer::~VerifyRingServer() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (base_) {
+        munmap(base_, size_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        shm_unlink(name_);
+    }
+#endif
+}
+
+bool VerifyRingServer::create(const char* name, size_t capacity) {
+#if defined(__unix__) || defined(__APPLE__)
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    shm_unlink(name);  // replace any stale segment
+    fd_ = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd_ < 0) {
+        return false;
+    }
+    std::strncpy(name_, name, sizeof(name_) - 1);
+    name_[sizeof(name_) - 1] = '\0';
+
+    size_ = segmentSize(rounded);
+    if (ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+        return false;
+    }
+    base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        return false;
+    }
+
+    Header* header = static_cast<Header*>(base_);
+    header->capacity = static_cast<uint32_t>(rounded);
+    header->enqueue.store(0, std::memory_order_relaxed);
+    header->dequeue.store(0, std::memory_order_relaxed);
+    header->doorbell.store(0, std::memory_order_relaxed);
+    header->stop.store(0, std::memory_order_relaxed);
+
+    Slot* ring = slots(base_);
+    Completion* cells = completions(base_, rounded);
+    for (size_t i = 0; i < rounded; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+        cells[i].state.store(CELL_FREE, std::memory_order_relaxed);
+    }
+
+    // Publish the magic last so clients never see a half-built segment
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = RING_MAGIC;
+    return true;
+#else
+    (void)name;
+    (void)capacity;
+    return false;
+#endif
+}
+
+void VerifyRingServer::run() {
+    if (!base_) {
+        return;
+    }
+    Header* header = static_cast<Header*>(base_);
+    Completion* cells = completions(base_, header->capacity);
+    SECP256k1Wrapper wrapper;
+
+    Request batch[MAX_BATCH];
+    VerifyJob jobs[MAX_BATCH];
+    uint64_t results[(MAX_BATCH + 63) / 64];
+
+    while (header->stop.load(std::memory_order_acquire) == 0) {
+        // Drain a batch of verifies; signs are handled inline
+        size_t verifies = 0;
+        Request request;
+        while (verifies < MAX_BATCH && dequeueRequest(header, request)) {
+            if (request.op == RingOp::Sign) {
+                Completion& cell = cells[request.completion];
+                cell.ok = wrapper.sign(
+                    request.key, request.messageHash,
+                    cell.signature, &cell.recoveryId) ? 1 : 0;
+                cell.state.store(CELL_DONE, std::memory_order_release);
+                futexWake(cell.state, 1);
+                continue;
+            }
+            batch[verifies] = request;
+            jobs[verifies].publicKey = batch[verifies].key;
+            jobs[verifies].messageHash = batch[verifies].messageHash;
+            jobs[verifies].signature = batch[verifies].signature;
+            ++verifies;
+        }
+
+        if (verifies > 0) {
+            wrapper.verifyBatch(jobs, verifies, results);
+            for (size_t i = 0; i < verifies; ++i) {
+                Completion& cell = cells[batch[i].completion];
+                cell.ok = (results[i / 64] >> (i % 64)) & 1;
+                cell.state.store(CELL_DONE, std::memory_order_release);
+                futexWake(cell.state, 1);
+            }
+            continue;
+        }
+
+        // Empty: park on the doorbell until a producer rings it
+        const uint32_t ticket = header->doorbell.load(std::memory_order_acquire);
+        Request probe;
+        if (dequeueRequest(header, probe)) {
+            // Raced with a producer; handle it next loop by re-queuing
+            // through the normal path
+            if (probe.op == RingOp::Sign) {
+                Completion& cell = cells[probe.completion];
+                cell.ok = wrapper.sign(
+                    probe.key, probe.messageHash,
+                    cell.signature, &cell.recoveryId) ? 1 : 0;
+                cell.state.store(CELL_DONE, std::memory_order_release);
+                futexWake(cell.state, 1);
+            } else {
+                VerifyJob job = {probe.key, probe.messageHash, probe.signature};
+                uint64_t bit = 0;
+                wrapper.verifyBatch(&job, 1, &bit);
+                Completion& cell = cells[probe.completion];
+                cell.ok = bit & 1;
+                cell.state.store(CELL_DONE, std::memory_order_release);
+                futexWake(cell.state, 1);
+            }
+            continue;
+        }
+        if (header->stop.load(std::memory_order_acquire) != 0) {
+            break;
+        }
+        futexWait(header->doorbell, ticket);
+    }
+}
+
+void VerifyRingServer::stop() {
+    if (!base_) {
+        return;
+    }
+    Header* header = static_cast<Header*>(base_);
+    header->stop.store(1, std::memory_order_release);
+    header->doorbell.fetch_add(1, std::memory_order_release);
+    futexWake(header->doorbell, INT32_MAX);
+}
+
+// --- client ------------------------------------------------------------------
+
+VerifyRingClient::VerifyRingClient() : base_(nullptr), size_(0) {
+}
+
+VerifyRingClient::~VerifyRingClient() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (base_) {
+        munmap(base_, size_);
+    }
+#endif
+}
+
+bool VerifyRingClient::open(const char* name) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    Header probe;
+    if (pread(fd, &probe, sizeof(probe), 0) != sizeof(probe) ||
+        probe.magic != RING_MAGIC) {
+        close(fd);
+        return false;
+    }
+
+    size_ = segmentSize(probe.capacity);
+    base_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // mapping keeps the segment alive
+    if (base_ == MAP_FAILED) {
+        base_ = nullptr;
+        return false;
+    }
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+bool VerifyRingClient::verify(
+    const uint8_t publicKey[64],
+    const uint8_t messageHash[32],
+    const uint8_t signature[64]
+) {
+    if (!base_) {
+        return false;
+    }
+    Header* header = static_cast<Header*>(base_);
+    Completion* cells = completions(base_, header->capacity);
+
+    const uint32_t cell = claimCompletion(header);
+    enqueueRequest(header, RingOp::Verify, cell, publicKey, messageHash, signature);
+
+    while (cells[cell].state.load(std::memory_order_acquire) != CELL_DONE) {
+        futexWait(cells[cell].state, CELL_PENDING);
+    }
+    const bool ok = cells[cell].ok != 0;
+    cells[cell].state.store(CELL_FREE, std::memory_order_release);
+    return ok;
+}
+
+bool VerifyRingClient::sign(
+    const uint8_t privateKey[32],
+    const uint8_t messageHash[32],
+    uint8_t signature[64],
+    uint8_t* recoveryId
+) {
+    if (!base_) {
+        return false;
+    }
+    Header* header = static_cast<Header*>(base_);
+    Completion* cells = completions(base_, header->capacity);
+
+    const uint32_t cell = claimCompletion(header);
+    enqueueRequest(header, RingOp::Sign, cell, privateKey, messageHash, nullptr);
+
+    while (cells[cell].state.load(std::memory_order_acquire) != CELL_DONE) {
+        futexWait(cells[cell].state, CELL_PENDING);
+    }
+    const bool ok = cells[cell].ok != 0;
+    if (ok) {
+        std::memcpy(signature, cells[cell].signature, 64);
+        if (recoveryId) {
+            *recoveryId = cells[cell].recoveryId;
+        }
+    }
+    cells[cell].state.store(CELL_FREE, std::memory_order_release);
+    return ok;
+}
+
+} // namespace crypto
+} // namespace whisper
@@ -0,0 +1,118 @@
+#ifndef WHISPER_CRYPTO_SHM_RING_H
+#define WHISPER_CRYPTO_SHM_RING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Shared-memory request ring for multi-process deployments
+ *
+ * One verifier process per NUMA node used to be fed over a Unix
+ * socket, serializing and copying every request. The ring instead
+ * lives in a shm_open segment both sides map: producers claim
+ * cache-line-aligned slots MPMC-style (Vyukov sequence numbers), write
+ * the fixed-size request in place, and futex-wake the server; the
+ * server drains slots into SECP256k1Wrapper batch calls and posts each
+ * result to a completion cell the client parks on. No socket, no
+ * serialization, one copy out of the shared slot on the server side.
+ *
+ * Linux-only parking (futex); other platforms fall back to yielding
+ * spins. Capacity is rounded up to a power of two.
+ */
+
+/// Request kinds carried by a ring slot
+enum class RingOp : uint8_t {
+    Verify = 0,
+    Sign = 1
+};
+
+/**
+ * @brief Server side: owns the segment and drains requests
+ */
+class VerifyRingServer {
+public:
+    VerifyRingServer();
+    ~VerifyRingServer();
+
+    VerifyRingServer(const VerifyRingServer&) = delete;
+    VerifyRingServer& operator=(const VerifyRingServer&) = delete;
+
+    /**
+     * @brief Create (or replace) the named segment
+     * @param name shm name, e.g. "/whisper-verify"
+     * @param capacity Slot count, rounded up to a power of two
+     */
+    bool create(const char* name, size_t capacity = 1024);
+
+    /**
+     * @brief Drain requests until stop() is called
+     *
+     * Parks on the ring's futex doorbell when idle; batches up to 64
+     * verifies per SECP256k1Wrapper::verifyBatch call.
+     */
+    void run();
+
+    /**
+     * @brief Make run() return; callable from another thread
+     */
+    void stop();
+
+private:
+    void* base_;
+    size_t size_;
+    int fd_;
+    char name_[64];
+};
+
+/**
+ * @brief Client side: maps an existing segment and submits requests
+ *
+ * Safe to use from several threads of one process and from several
+ * processes at once.
+ */
+class VerifyRingClient {
+public:
+    VerifyRingClient();
+    ~VerifyRingClient();
+
+    VerifyRingClient(const VerifyRingClient&) = delete;
+    VerifyRingClient& operator=(const VerifyRingClient&) = delete;
+
+    /**
+     * @brief Map a segment created by VerifyRingServer
+     */
+    bool open(const char* name);
+
+    /**
+     * @brief Round-trip verify through the server
+     * @return true when the signature verified
+     */
+    bool verify(
+        const uint8_t publicKey[64],
+        const uint8_t messageHash[32],
+        const uint8_t signature[64]
+    );
+
+    /**
+     * @brief Round-trip sign through the server
+     */
+    bool sign(
+        const uint8_t privateKey[32],
+        const uint8_t messageHash[32],
+        uint8_t signature[64],
+        uint8_t* recoveryId
+    );
+
+private:
+    void* base_;
+    size_t size_;
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_SHM_RING_H
@@ -0,0 +1,156 @@
+/**
+ * Hot-path latency instrumentation
+ *
+ * Recording touches only the calling thread's padded slots; the global
+ * registry mutex is taken on thread start/exit and in snapshot()/
+ * reset(), never on the sample path.
+ */
+
+#include "stats.h"
+
+#ifdef WHISPER_ENABLE_STATS
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace whisper {
+namespace crypto {
+
+namespace {
+
+constexpr size_t OP_COUNT = static_cast<size_t>(StatOp::Count);
+
+const char* const OP_NAMES[OP_COUNT] = {
+    "keccak_update",
+    "keccak_finalize",
+    "sign",
+    "verify",
+    "recover",
+    "verify_batch",
+};
+
+void clearSlot(detail::OpSlot& slot) {
+    std::memset(&slot, 0, sizeof(slot));
+    slot.minCycles = UINT64_MAX;
+}
+
+void mergeSlot(detail::OpSlot& into, const detail::OpSlot& from) {
+    into.count += from.count;
+    into.totalCycles += from.totalCycles;
+    into.minCycles = std::min(into.minCycles, from.minCycles);
+    into.maxCycles = std::max(into.maxCycles, from.maxCycles);
+    for (size_t i = 0; i < Stats::BUCKET_COUNT; ++i) {
+        into.buckets[i] += from.buckets[i];
+    }
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<detail::ThreadStats*> live;
+    detail::OpSlot retired[OP_COUNT];
+
+    Registry() {
+        for (detail::OpSlot& slot : retired) {
+            clearSlot(slot);
+        }
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+} // namespace
+
+namespace detail {
+
+ThreadStats::ThreadStats() {
+    for (OpSlot& slot : ops) {
+        clearSlot(slot);
+    }
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.live.push_back(this);
+}
+
+ThreadStats::~ThreadStats() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        mergeSlot(reg.retired[i], ops[i]);
+    }
+    reg.live.erase(std::find(reg.live.begin(), reg.live.end(), this));
+}
+
+ThreadStats& threadStats() {
+    thread_local ThreadStats stats;
+    return stats;
+}
+
+void record(StatOp op, uint64_t cycles) {
+    OpSlot& slot = threadStats().ops[static_cast<size_t>(op)];
+    ++slot.count;
+    slot.totalCycles += cycles;
+    slot.minCycles = std::min(slot.minCycles, cycles);
+    slot.maxCycles = std::max(slot.maxCycles, cycles);
+    const unsigned bucket = cycles ? 63u - __builtin_clzll(cycles) : 0u;
+    ++slot.buckets[bucket];
+}
+
+} // namespace detail
+
+std::vector<OpStats> Stats::snapshot() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::vector<OpStats> out(OP_COUNT);
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        detail::OpSlot merged = reg.retired[i];
+        for (detail::ThreadStats* thread : reg.live) {
+            mergeSlot(merged, thread->ops[i]);
+        }
+        OpStats& op = out[i];
+        op.name = OP_NAMES[i];
+        op.count = merged.count;
+        op.totalCycles = merged.totalCycles;
+        op.minCycles = merged.count ? merged.minCycles : 0;
+        op.maxCycles = merged.maxCycles;
+        std::memcpy(op.buckets, merged.buckets, sizeof(op.buckets));
+    }
+    return out;
+}
+
+void Stats::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (detail::OpSlot& slot : reg.retired) {
+        clearSlot(slot);
+    }
+    for (detail::ThreadStats* thread : reg.live) {
+        for (detail::OpSlot& slot : thread->ops) {
+            clearSlot(slot);
+        }
+    }
+}
+
+} // namespace crypto
+} // namespace whisper
+
+#else // instrumentation compiled out
+
+namespace whisper {
+namespace crypto {
+
+std::vector<OpStats> Stats::snapshot() {
+    return {};
+}
+
+void Stats::reset() {
+}
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_ENABLE_STATS
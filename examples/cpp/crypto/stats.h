@@ -0,0 +1,128 @@
+#ifndef WHISPER_CRYPTO_STATS_H
+#define WHISPER_CRYPTO_STATS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Instrumented hot-path operations
+ */
+enum class StatOp : size_t {
+    KeccakUpdate = 0,
+    KeccakFinalize,
+    Sign,
+    Verify,
+    Recover,
+    VerifyBatch,
+    Count
+};
+
+/**
+ * @brief Aggregated timing for one operation
+ *
+ * Buckets are powers of two: bucket i counts samples whose cycle cost
+ * fell in [2^i, 2^(i+1)).
+ */
+struct OpStats {
+    const char* name;
+    uint64_t count;
+    uint64_t totalCycles;
+    uint64_t minCycles;
+    uint64_t maxCycles;
+    uint64_t buckets[64];
+};
+
+/**
+ * @brief Opt-in latency instrumentation for the crypto hot paths
+ *
+ * Built only when the library is configured with WHISPER_ENABLE_STATS;
+ * otherwise every probe compiles out and snapshot() returns nothing.
+ * Samples are RDTSC deltas recorded into per-thread, cache-line-padded
+ * slots (no cross-thread writes on the hot path); snapshot() merges
+ * live threads with totals folded in from exited ones. Counters are
+ * read without synchronization, which is fine for monitoring.
+ */
+class Stats {
+public:
+    static constexpr size_t BUCKET_COUNT = 64;
+
+#ifdef WHISPER_ENABLE_STATS
+    static constexpr bool enabled() { return true; }
+#else
+    static constexpr bool enabled() { return false; }
+#endif
+
+    /**
+     * @brief Merged counters for every instrumented operation
+     */
+    static std::vector<OpStats> snapshot();
+
+    /**
+     * @brief Zero all counters, live and retired
+     */
+    static void reset();
+};
+
+#ifdef WHISPER_ENABLE_STATS
+
+namespace detail {
+
+/// One operation's counters, padded to its own cache line
+struct alignas(64) OpSlot {
+    uint64_t count;
+    uint64_t totalCycles;
+    uint64_t minCycles;
+    uint64_t maxCycles;
+    uint64_t buckets[Stats::BUCKET_COUNT];
+};
+
+/// Per-thread slot block; registers itself for snapshot() and folds
+/// its totals into the retired accumulator on thread exit
+struct ThreadStats {
+    OpSlot ops[static_cast<size_t>(StatOp::Count)];
+
+    ThreadStats();
+    ~ThreadStats();
+};
+
+ThreadStats& threadStats();
+void record(StatOp op, uint64_t cycles);
+
+inline uint64_t readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// RAII probe timing one call
+class ScopedTimer {
+public:
+    explicit ScopedTimer(StatOp op) : op_(op), start_(readCycles()) {}
+    ~ScopedTimer() { record(op_, readCycles() - start_); }
+
+private:
+    StatOp op_;
+    uint64_t start_;
+};
+
+} // namespace detail
+
+#endif // WHISPER_ENABLE_STATS
+
+} // namespace crypto
+} // namespace whisper
+
+#ifdef WHISPER_ENABLE_STATS
+#define WHISPER_STATS_SCOPE(op) \
+    ::whisper::crypto::detail::ScopedTimer whisperStatsScope_(::whisper::crypto::StatOp::op)
+#else
+#define WHISPER_STATS_SCOPE(op)
+#endif
+
+#endif // WHISPER_CRYPTO_STATS_H
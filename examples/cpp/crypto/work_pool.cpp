@@ -0,0 +1,225 @@
+/**
+ * Work-stealing thread pool for parallel sign/verify/hash jobs
+ */
+
+#include "work_pool.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace whisper {
+namespace crypto {
+
+namespace {
+
+// Unpinned, single-domain placement for the plain constructor
+WorkPool::Topology flatTopology(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+    }
+    WorkPool::Topology topology;
+    topology.workerCpus.assign(threadCount, -1);
+    return topology;
+}
+
+void pinToCpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);  // best effort
+#else
+    (void)cpu;
+#endif
+}
+
+} // namespace
+
+WorkPool::WorkPool(size_t threadCount) : WorkPool(flatTopology(threadCount)) {
+}
+
+WorkPool::WorkPool(const Topology& topology) {
+    size_t threadCount = topology.workerCpus.size();
+    if (topology.workerNodes.size() > threadCount) {
+        threadCount = topology.workerNodes.size();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    workers_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        if (i < topology.workerCpus.size()) {
+            worker->cpu = topology.workerCpus[i];
+        }
+        if (i < topology.workerNodes.size()) {
+            worker->node = topology.workerNodes[i];
+        }
+        workers_.push_back(std::move(worker));
+    }
+
+    // Victim order: same-node workers first, then the rest, each group
+    // rotated by the thief's index to spread contention
+    for (size_t i = 0; i < threadCount; ++i) {
+        Worker& self = *workers_[i];
+        for (size_t offset = 1; offset < threadCount; ++offset) {
+            const size_t victim = (i + offset) % threadCount;
+            if (workers_[victim]->node == self.node) {
+                self.stealOrder.push_back(victim);
+            }
+        }
+        for (size_t offset = 1; offset < threadCount; ++offset) {
+            const size_t victim = (i + offset) % threadCount;
+            if (workers_[victim]->node != self.node) {
+                self.stealOrder.push_back(victim);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_[i]->thread = std::thread([this, i] { workerLoop(i); });
+    }
+}
+
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_.store(true, std::memory_order_release);
+    }
+    wakeCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void WorkPool::enqueue(Job job) {
+    // Round-robin across worker deques; stealing evens out imbalance
+    const size_t index = nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->jobs.push_back(std::move(job));
+    }
+    wakeCv_.notify_one();
+}
+
+bool WorkPool::tryPop(size_t index, Job& job) {
+    // Own deque first (LIFO for cache warmth)
+    {
+        Worker& self = *workers_[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.jobs.empty()) {
+            job = std::move(self.jobs.back());
+            self.jobs.pop_back();
+            return true;
+        }
+    }
+
+    // Steal from the front of a victim's deque, exhausting same-node
+    // victims before pulling work across the interconnect
+    for (size_t victimIndex : workers_[index]->stealOrder) {
+        Worker& victim = *workers_[victimIndex];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkPool::workerLoop(size_t index) {
+    Worker& self = *workers_[index];
+    pinToCpu(self.cpu);
+
+    // Construct the context after pinning so first-touch places its
+    // precomputed tables on the local node
+    self.wrapper = std::make_unique<SECP256k1Wrapper>();
+    SECP256k1Wrapper& wrapper = *self.wrapper;
+
+    for (;;) {
+        Job job;
+        if (tryPop(index, job)) {
+            job(wrapper);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        if (stopping_.load(std::memory_order_acquire)) {
+            // Drain remaining work before exiting
+            lock.unlock();
+            while (tryPop(index, job)) {
+                job(wrapper);
+            }
+            return;
+        }
+        wakeCv_.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+std::future<std::array<uint8_t, 32>> WorkPool::submitHash(const uint8_t* data, size_t length) {
+    auto promise = std::make_shared<std::promise<std::array<uint8_t, 32>>>();
+    auto future = promise->get_future();
+    enqueue([promise, data, length](SECP256k1Wrapper&) {
+        std::array<uint8_t, 32> digest;
+        Keccak256 hasher;
+        hasher.update(data, length);
+        hasher.finalize(digest.data());
+        promise->set_value(digest);
+    });
+    return future;
+}
+
+std::future<bool> WorkPool::submitVerify(
+    const uint8_t* publicKey,
+    const uint8_t* messageHash,
+    const uint8_t* signature
+) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+    enqueue([promise, publicKey, messageHash, signature](SECP256k1Wrapper& wrapper) {
+        promise->set_value(wrapper.verify(publicKey, messageHash, signature));
+    });
+    return future;
+}
+
+std::future<SignJobResult> WorkPool::submitSign(
+    const uint8_t* privateKey,
+    const uint8_t* messageHash
+) {
+    auto promise = std::make_shared<std::promise<SignJobResult>>();
+    auto future = promise->get_future();
+    enqueue([promise, privateKey, messageHash](SECP256k1Wrapper& wrapper) {
+        SignJobResult result;
+        std::memset(result.signature, 0, sizeof(result.signature));
+        result.recoveryId = 0;
+        result.ok = wrapper.sign(privateKey, messageHash, result.signature, &result.recoveryId);
+        promise->set_value(result);
+    });
+    return future;
+}
+
+std::future<void> WorkPool::submitJob(Job job) {
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    enqueue([promise, job = std::move(job)](SECP256k1Wrapper& wrapper) {
+        job(wrapper);
+        promise->set_value();
+    });
+    return future;
+}
+
+} // namespace crypto
+} // namespace whisper
@@ -0,0 +1,137 @@
+#ifndef WHISPER_CRYPTO_WORK_POOL_H
+#define WHISPER_CRYPTO_WORK_POOL_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "keccak256.h"
+#include "secp256k1_wrapper.h"
+
+namespace whisper {
+namespace crypto {
+
+/**
+ * @brief Result of an asynchronous sign job
+ */
+struct SignJobResult {
+    bool ok;
+    uint8_t signature[64];
+    uint8_t recoveryId;
+};
+
+/**
+ * @brief Work-stealing thread pool for crypto jobs
+ *
+ * Each worker owns a deque (local push/pop at the back, thieves steal
+ * from the front) and a long-lived SECP256k1Wrapper, so signing and
+ * verification reuse a per-thread context instead of rebuilding
+ * precomputed tables per call.
+ *
+ * Input buffers passed to submit* must stay valid until the returned
+ * future is ready.
+ */
+class WorkPool {
+public:
+    /// Job body; receives the worker's thread-local wrapper
+    using Job = std::function<void(SECP256k1Wrapper&)>;
+
+    /**
+     * @brief Worker placement for NUMA machines
+     *
+     * One entry per worker. Pinning keeps each wrapper's precomputed
+     * tables on the core that touched them, and the node ids form
+     * steal domains: a hungry worker exhausts same-node victims before
+     * crossing the interconnect. Callers map this to their IRQ/NIC
+     * layout, e.g. one pool per socket feeding from the local NIC.
+     */
+    struct Topology {
+        /// CPU to pin each worker to; -1 leaves that worker unpinned
+        std::vector<int> workerCpus;
+        /// NUMA node of each worker; missing entries default to node 0
+        std::vector<int> workerNodes;
+    };
+
+    /**
+     * @brief Start the pool
+     * @param threadCount Worker count; 0 selects hardware_concurrency
+     */
+    explicit WorkPool(size_t threadCount = 0);
+
+    /**
+     * @brief Start a pool with explicit worker placement
+     *
+     * Worker count is the topology's entry count. Each worker pins
+     * itself before constructing its SECP256k1Wrapper, so first-touch
+     * places the context's tables node-local.
+     */
+    explicit WorkPool(const Topology& topology);
+    ~WorkPool();
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /**
+     * @brief Hash a buffer on the pool
+     * @return Future resolving to the 32-byte Keccak-256 digest
+     */
+    std::future<std::array<uint8_t, 32>> submitHash(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Verify a signature on the pool
+     */
+    std::future<bool> submitVerify(
+        const uint8_t* publicKey,
+        const uint8_t* messageHash,
+        const uint8_t* signature
+    );
+
+    /**
+     * @brief Sign a message hash on the pool
+     */
+    std::future<SignJobResult> submitSign(
+        const uint8_t* privateKey,
+        const uint8_t* messageHash
+    );
+
+    /**
+     * @brief Run an arbitrary job on the pool
+     */
+    std::future<void> submitJob(Job job);
+
+    size_t threadCount() const { return workers_.size(); }
+
+private:
+    struct Worker {
+        std::deque<Job> jobs;
+        std::mutex mutex;
+        std::unique_ptr<SECP256k1Wrapper> wrapper;
+        std::thread thread;
+        int cpu = -1;
+        int node = 0;
+        std::vector<size_t> stealOrder;  // same-node victims first
+    };
+
+    void enqueue(Job job);
+    void workerLoop(size_t index);
+    bool tryPop(size_t index, Job& job);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    std::atomic<size_t> nextWorker_{0};
+    std::atomic<bool> stopping_{false};
+};
+
+} // namespace crypto
+} // namespace whisper
+
+#endif // WHISPER_CRYPTO_WORK_POOL_H
@@ -0,0 +1,141 @@
+/**
+ * Keccak-256 fast-path cross-checks
+ * Every accelerated path (batch kernel, bulk absorb, constexpr, XOF,
+ * midstate fork) must match the scalar byte-serial reference exactly
+ */
+
+#include "crypto/keccak256.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using whisper::crypto::Keccak256;
+using whisper::crypto::keccak256;
+
+static void fail(const char* what) {
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    std::exit(1);
+}
+
+// Byte-serial reference: one update() call per input byte
+static void referenceHash(const uint8_t* data, size_t length, uint8_t digest[32]) {
+    Keccak256 hasher;
+    for (size_t i = 0; i < length; ++i) {
+        hasher.update(data + i, 1);
+    }
+    hasher.finalize(digest);
+}
+
+// Deterministic xorshift PRNG so failures reproduce exactly
+static uint64_t nextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// Compile-time evaluation pinned against the known empty-input digest
+static_assert(keccak256("")[0] == 0xc5 && keccak256("")[31] == 0x70,
+              "constexpr keccak256 empty-input digest");
+static_assert(keccak256("abc")[0] == 0x4e && keccak256("abc")[31] == 0x45,
+              "constexpr keccak256 short-input digest");
+
+int main() {
+    uint64_t rng = 0x243F6A8885A308D3ULL;
+
+    // Message lengths straddling the rate boundary (0..3 blocks)
+    std::vector<uint8_t> data(3 * Keccak256::RATE_BYTES + 7);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(nextRandom(rng));
+    }
+
+    for (size_t length = 0; length <= data.size(); ++length) {
+        uint8_t expected[32];
+        referenceHash(data.data(), length, expected);
+
+        // Bulk absorb in one update() call
+        uint8_t actual[32];
+        Keccak256 hasher;
+        hasher.update(data.data(), length);
+        hasher.finalize(actual);
+        if (std::memcmp(actual, expected, 32) != 0) fail("bulk absorb vs reference");
+
+        // Fuzzed split points: random number of update() calls
+        hasher.reset();
+        size_t offset = 0;
+        while (offset < length) {
+            size_t piece = nextRandom(rng) % (length - offset) + 1;
+            hasher.update(data.data() + offset, piece);
+            offset += piece;
+        }
+        hasher.finalize(actual);
+        if (std::memcmp(actual, expected, 32) != 0) fail("split update vs reference");
+
+        // constexpr path, evaluated here at runtime over dynamic input
+        std::string_view view(reinterpret_cast<const char*>(data.data()), length);
+        if (std::memcmp(keccak256(view).data(), expected, 32) != 0) {
+            fail("constexpr keccak256 vs reference");
+        }
+
+        // XOF: first 32 squeezed bytes equal the digest, and squeezing
+        // in ragged pieces matches one large squeeze
+        uint8_t stream[200];
+        Keccak256 xof;
+        xof.update(data.data(), length);
+        xof.squeeze(stream, sizeof(stream));
+        if (std::memcmp(stream, expected, 32) != 0) fail("squeeze prefix vs finalize");
+
+        uint8_t pieces[200];
+        xof.reset();
+        xof.update(data.data(), length);
+        offset = 0;
+        while (offset < sizeof(pieces)) {
+            size_t piece = nextRandom(rng) % (sizeof(pieces) - offset) + 1;
+            xof.squeeze(pieces + offset, piece);
+            offset += piece;
+        }
+        if (std::memcmp(pieces, stream, sizeof(stream)) != 0) fail("split squeeze vs bulk");
+    }
+
+    // hashBatch (SIMD kernel when available) vs per-message hashing,
+    // with lengths chosen to hit full groups of four plus a remainder
+    const size_t count = 23;
+    std::vector<std::vector<uint8_t>> messages(count);
+    std::vector<const uint8_t*> inputs(count);
+    std::vector<size_t> lengths(count);
+    for (size_t i = 0; i < count; ++i) {
+        messages[i].resize(i * 31);
+        for (auto& byte : messages[i]) byte = static_cast<uint8_t>(nextRandom(rng));
+        inputs[i] = messages[i].data();
+        lengths[i] = messages[i].size();
+    }
+    std::vector<uint8_t> batchDigests(count * 32);
+    Keccak256::hashBatch(inputs.data(), lengths.data(), count, batchDigests.data());
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t expected[32];
+        referenceHash(inputs[i], lengths[i], expected);
+        if (std::memcmp(batchDigests.data() + i * 32, expected, 32) != 0) {
+            fail("hashBatch vs reference");
+        }
+    }
+
+    // Forked midstate continues identically to the original prefix
+    Keccak256 prefix;
+    prefix.update(data.data(), 100);
+    for (size_t suffix = 0; suffix < 64; ++suffix) {
+        uint8_t expected[32];
+        Keccak256 whole;
+        whole.update(data.data(), 100 + suffix);
+        whole.finalize(expected);
+
+        uint8_t actual[32];
+        Keccak256 forked = prefix.fork();
+        forked.update(data.data() + 100, suffix);
+        forked.finalize(actual);
+        if (std::memcmp(actual, expected, 32) != 0) fail("fork midstate vs whole");
+    }
+
+    std::printf("test_keccak_paths: ok\n");
+    return 0;
+}
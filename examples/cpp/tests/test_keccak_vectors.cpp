@@ -0,0 +1,41 @@
+/**
+ * Keccak-256 known-answer tests
+ * Official vectors plus Ethereum's empty-input hash
+ */
+
+#include "crypto/keccak256.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using whisper::crypto::Keccak256;
+
+static void expectHash(const std::string& input, const char* expected) {
+    const std::string actual = Keccak256::hash(input);
+    if (actual != expected) {
+        std::fprintf(stderr, "FAIL: keccak256(%zu bytes)\n  expected %s\n  actual   %s\n",
+                     input.size(), expected, actual.c_str());
+        std::exit(1);
+    }
+}
+
+int main() {
+    // Ethereum's well-known empty hash (e.g. the empty account code hash)
+    expectHash("", "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+
+    expectHash("abc",
+               "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    expectHash("The quick brown fox jumps over the lazy dog",
+               "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15");
+    expectHash("The quick brown fox jumps over the lazy dog.",
+               "578951e24efd62a3d63a86f7cd19aaa53c898fe287d2552133220370240b572d");
+    expectHash("testing",
+               "5f16f4c7f149ac4f9510d9cf8cf384038ad348b3bcdc01915f95de12df9d1b02");
+
+    // Exactly one rate block of input forces the two-permutation path
+    expectHash(std::string(136, 'a'),
+               "a6c4d403279fe3e0af03729caada8374b5ca54d8065329a3ebcaeb4b60aa386e");
+
+    std::printf("test_keccak_vectors: ok\n");
+    return 0;
+}
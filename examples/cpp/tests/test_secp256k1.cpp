@@ -0,0 +1,136 @@
+/**
+ * SECP256k1 wrapper tests
+ * Generator known-answer check plus sign/verify/recover round trips,
+ * determinism, batching and the compressed-key paths
+ */
+
+#include "crypto/keccak256.h"
+#include "crypto/secp256k1_wrapper.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace whisper::crypto;
+
+static void fail(const char* what) {
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    std::exit(1);
+}
+
+int main() {
+    SECP256k1Wrapper wrapper;
+
+    // Private key 1 must derive the generator point itself
+    uint8_t one[32] = {};
+    one[31] = 1;
+    uint8_t generator[64];
+    if (!wrapper.derivePublicKey(one, generator)) fail("derive for key 1");
+    if (SECP256k1Wrapper::bytesToHex(generator, 64) !=
+        "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+        "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8") {
+        fail("generator coordinates");
+    }
+
+    // Out-of-range keys are rejected
+    uint8_t zero[32] = {};
+    uint8_t scratch[64];
+    if (wrapper.derivePublicKey(zero, scratch)) fail("zero key accepted");
+
+    KeyPair keyPair = wrapper.generateKeyPair();
+    uint8_t hash[32];
+    std::memset(hash, 0x5A, sizeof(hash));
+
+    // Sign / verify / recover round trip, deterministic signatures
+    uint8_t signature[64], again[64];
+    uint8_t recoveryId, recoveryIdAgain;
+    if (!wrapper.sign(keyPair.privateKey, hash, signature, &recoveryId)) fail("sign");
+    if (!wrapper.sign(keyPair.privateKey, hash, again, &recoveryIdAgain)) fail("re-sign");
+    if (std::memcmp(signature, again, 64) != 0 || recoveryId != recoveryIdAgain) {
+        fail("signatures not deterministic");
+    }
+    if (!wrapper.verify(keyPair.publicKey, hash, signature)) fail("verify");
+
+    uint8_t recovered[64];
+    if (!wrapper.recoverPublicKey(hash, signature, recoveryId, recovered)) fail("recover");
+    if (std::memcmp(recovered, keyPair.publicKey, 64) != 0) fail("recovered wrong key");
+
+    // A flipped message bit must not verify
+    hash[0] ^= 1;
+    if (wrapper.verify(keyPair.publicKey, hash, signature)) fail("tampered hash verified");
+    hash[0] ^= 1;
+
+    // signBatch output is byte-identical to lone sign() calls
+    const size_t count = 16;
+    uint8_t hashes[count][32];
+    for (size_t i = 0; i < count; ++i) std::memset(hashes[i], int(i + 1), 32);
+    uint8_t signatures[count * 64];
+    uint8_t recoveryIds[count];
+    if (!wrapper.signBatch(keyPair.privateKey, hashes, count, signatures, recoveryIds)) {
+        fail("signBatch");
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t single[64], singleId;
+        if (!wrapper.sign(keyPair.privateKey, hashes[i], single, &singleId)) fail("sign one");
+        if (std::memcmp(single, signatures + i * 64, 64) != 0 || singleId != recoveryIds[i]) {
+            fail("signBatch differs from sign");
+        }
+    }
+
+    // verifyBatch bitmask, with one corrupted job in the middle
+    VerifyJob jobs[count];
+    for (size_t i = 0; i < count; ++i) {
+        jobs[i].publicKey = keyPair.publicKey;
+        jobs[i].messageHash = hashes[i];
+        jobs[i].signature = signatures + i * 64;
+    }
+    uint8_t corrupted[64];
+    std::memcpy(corrupted, signatures + 7 * 64, 64);
+    corrupted[10] ^= 1;
+    jobs[7].signature = corrupted;
+    uint64_t results[1] = {};
+    if (wrapper.verifyBatch(jobs, count, results) != count - 1) fail("verifyBatch count");
+    for (size_t i = 0; i < count; ++i) {
+        const bool ok = (results[0] >> i) & 1;
+        if (ok != (i != 7)) fail("verifyBatch bitmask");
+    }
+
+    // Compressed-key round trip and the cached verify path
+    uint8_t compressed[33];
+    SECP256k1Wrapper::compress(keyPair.publicKey, compressed);
+    uint8_t expanded[64];
+    if (!SECP256k1Wrapper::decompress(compressed, expanded)) fail("decompress");
+    if (std::memcmp(expanded, keyPair.publicKey, 64) != 0) fail("decompress round trip");
+    compressed[0] ^= 0x04;  // 0x02 <-> 0x06: invalid prefix
+    if (SECP256k1Wrapper::decompress(compressed, expanded)) fail("bad prefix accepted");
+    compressed[0] ^= 0x04;
+    for (int pass = 0; pass < 2; ++pass) {  // second pass hits the cache
+        if (!wrapper.verifyCompressed(compressed, hash, signature)) fail("verifyCompressed");
+    }
+
+    uint8_t recoveredCompressed[33];
+    if (!wrapper.recoverPublicKeyCompressed(hash, signature, recoveryId, recoveredCompressed)) {
+        fail("recoverPublicKeyCompressed");
+    }
+    if (std::memcmp(recoveredCompressed, compressed, 33) != 0) {
+        fail("recovered compressed key differs");
+    }
+
+    // Address fast path: expected address is the digest tail of the key
+    uint8_t keyDigest[32];
+    Keccak256 hasher;
+    hasher.update(keyPair.publicKey, 64);
+    hasher.finalize(keyDigest);
+    const uint8_t* address = keyDigest + 12;
+    if (!wrapper.verifyAgainstAddress(hash, signature, recoveryId, address)) {
+        fail("verifyAgainstAddress");
+    }
+    uint8_t wrongAddress[20];
+    std::memcpy(wrongAddress, address, 20);
+    wrongAddress[0] ^= 1;
+    if (wrapper.verifyAgainstAddress(hash, signature, recoveryId, wrongAddress)) {
+        fail("wrong address accepted");
+    }
+
+    std::printf("test_secp256k1: ok\n");
+    return 0;
+}
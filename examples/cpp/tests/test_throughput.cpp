@@ -0,0 +1,91 @@
+/**
+ * Per-kernel throughput floors
+ * Not a benchmark: floors sit an order of magnitude below what the
+ * slowest supported hardware delivers, so a pass says only that no
+ * kernel has fallen off a performance cliff. Measured numbers are
+ * printed for the CI log; use the benchmarks/ targets for real numbers.
+ */
+
+#include "crypto/keccak256.h"
+#include "crypto/secp256k1_wrapper.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace whisper::crypto;
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void requireFloor(const char* kernel, double measured, double floor,
+                         const char* unit) {
+    std::printf("%-16s %10.1f %s (floor %.1f)\n", kernel, measured, unit, floor);
+    if (measured < floor) {
+        std::fprintf(stderr, "FAIL: %s below throughput floor\n", kernel);
+        std::exit(1);
+    }
+}
+
+int main() {
+    // Bulk absorb over a buffer large enough to stream from memory
+    const size_t bufferSize = 4 * 1024 * 1024;
+    std::vector<uint8_t> buffer(bufferSize, 0xA5);
+    uint8_t digest[32];
+    Keccak256 hasher;
+    auto start = Clock::now();
+    hasher.update(buffer.data(), buffer.size());
+    hasher.finalize(digest);
+    double elapsed = secondsSince(start);
+    requireFloor("keccak_bulk", bufferSize / elapsed / 1e6, 20.0, "MB/s");
+
+    // Batch kernel over many small messages (the SIMD path when built)
+    const size_t count = 256;
+    const size_t messageSize = 1024;
+    std::vector<const uint8_t*> inputs(count, buffer.data());
+    std::vector<size_t> lengths(count, messageSize);
+    std::vector<uint8_t> digests(count * 32);
+    start = Clock::now();
+    Keccak256::hashBatch(inputs.data(), lengths.data(), count, digests.data());
+    elapsed = secondsSince(start);
+    requireFloor("keccak_batch", count * messageSize / elapsed / 1e6, 20.0, "MB/s");
+
+    // Signing and verification, amortized over warm batches
+    SECP256k1Wrapper wrapper;
+    KeyPair keyPair = wrapper.generateKeyPair();
+    const size_t ops = 32;
+    uint8_t hashes[ops][32];
+    for (size_t i = 0; i < ops; ++i) std::memset(hashes[i], int(i + 1), 32);
+    uint8_t signatures[ops * 64];
+    uint8_t recoveryIds[ops];
+
+    wrapper.sign(keyPair.privateKey, hashes[0], signatures, recoveryIds);  // warm tables
+    start = Clock::now();
+    if (!wrapper.signBatch(keyPair.privateKey, hashes, ops, signatures, recoveryIds)) {
+        std::fprintf(stderr, "FAIL: signBatch\n");
+        return 1;
+    }
+    elapsed = secondsSince(start);
+    requireFloor("sign", ops / elapsed, 50.0, "ops/s");
+
+    VerifyJob jobs[ops];
+    for (size_t i = 0; i < ops; ++i) {
+        jobs[i].publicKey = keyPair.publicKey;
+        jobs[i].messageHash = hashes[i];
+        jobs[i].signature = signatures + i * 64;
+    }
+    uint64_t results[1] = {};
+    start = Clock::now();
+    if (wrapper.verifyBatch(jobs, ops, results) != ops) {
+        std::fprintf(stderr, "FAIL: verifyBatch\n");
+        return 1;
+    }
+    elapsed = secondsSince(start);
+    requireFloor("verify", ops / elapsed, 25.0, "ops/s");
+
+    std::printf("test_throughput: ok\n");
+    return 0;
+}